@@ -27,6 +27,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <cctype>
 #include <cmath>
 #include <ctime>
+#include <cstdio>
+#include <stdint.h>
+#include <algorithm>
+#include <stdexcept>
 
 
 using namespace boost::posix_time;
@@ -38,7 +42,7 @@ namespace scidb4geo
     using namespace std;
 
 
-    int countNextDigits ( string &s, int start )
+    int countNextDigits ( const string &s, int start )
     {
         int i = start;
         int len = s.length();
@@ -47,7 +51,7 @@ namespace scidb4geo
     }
 
 
-    int countNextNumberChars ( string &s, int start )
+    int countNextNumberChars ( const string &s, int start )
     {
         int i = start;
         int len = s.length();
@@ -71,34 +75,60 @@ namespace scidb4geo
         init();
     }
 
-    TPoint::TPoint ( string str )
+    /**
+    * Returns the character at pos or 0 if pos is beyond the end
+    */
+    static inline char charAt ( const string &s, int pos, int end )
+    {
+        return ( pos < end ) ? s[pos] : '\0';
+    }
+
+    /**
+    * Parses up to n digits in place, fails like boost::lexical_cast<int> ( s.substr ( pos, n ) ) would
+    */
+    static inline int parseDigits ( const string &s, int pos, int n, int end )
+    {
+        if ( pos + n > end ) n = end - pos;
+        if ( n <= 0 ) throw boost::bad_lexical_cast();
+        int v = 0;
+        for ( int i = pos; i < pos + n; ++i ) {
+            if ( !isdigit ( ( unsigned char ) s[i] ) ) throw boost::bad_lexical_cast();
+            v = v * 10 + ( s[i] - '0' );
+        }
+        return v;
+    }
+
+    TPoint::TPoint ( const string &str )
     {
         init();
         int ndig = 0;
         int pos = 0;
         int len = str.length();
-        boost::algorithm::trim ( str );
 
-        while ( pos < len && !isdigit ( str[pos] ) ) ++pos;
+        // trim without copying
+        while ( pos < len && isspace ( ( unsigned char ) str[pos] ) ) ++pos;
+        while ( len > pos && isspace ( ( unsigned char ) str[len - 1] ) ) --len;
+
+        while ( pos < len && !isdigit ( ( unsigned char ) str[pos] ) ) ++pos;
 
 
         if ( countNextDigits ( str, pos ) < 4 ) {
             // TODO: Error
         }
-        _year = boost::lexical_cast<int> ( str.substr ( pos, 4 ) );
+        _year = parseDigits ( str, pos, 4, len );
         pos += 4;
-        if ( len == pos ) {
+        if ( len <= pos ) {
             // END: Resolution YEAR
             _resolution = YEAR;
         }
         else {
             if ( str[pos] == '-' ) ++pos;
-            if ( str[pos] == 'W' ) {
+            if ( charAt ( str, pos, len ) == 'W' ) {
                 ++pos;
                 if ( countNextDigits ( str, pos ) < 2 ) {
                     // TODO: Error
                 }
-                _week = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                _week = parseDigits ( str, pos, 2, len );
                 // TODO: Assert week in [01,53]
                 pos += 2;
                 _resolution = WEEK;
@@ -108,7 +138,7 @@ namespace scidb4geo
                     if ( ndig != 1 ) {
                         // TODO: Error
                     }
-                    _dow = boost::lexical_cast<int> ( str.substr ( pos, 1 ) );
+                    _dow = parseDigits ( str, pos, 1, len );
                     // TODO: Assert dow in [1,7]
                     _resolution = DAY;
                     // READY, MAYBE TIME
@@ -119,7 +149,7 @@ namespace scidb4geo
             else {
                 ndig = countNextDigits ( str, pos );
                 if ( ndig == 3 ) {
-                    _doy = boost::lexical_cast<int> ( str.substr ( pos, 3 ) );
+                    _doy = parseDigits ( str, pos, 3, len );
                     // TODO: Assert doy in [001,365]
                     pos += 3;
                     _resolution = DAY;
@@ -127,7 +157,7 @@ namespace scidb4geo
 
                 }
                 else if ( ndig == 2 || ndig == 4 ) {
-                    _month = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                    _month = parseDigits ( str, pos, 2, len );
                     // TODO: Assert month in [01,12]
                     pos += 2;
                     _resolution = MONTH;
@@ -137,7 +167,7 @@ namespace scidb4geo
                         if ( ndig != 2 ) {
                             // TODO: Error
                         }
-                        _dom = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                        _dom = parseDigits ( str, pos, 2, len );
                         // TODO: Assert dom in [01,31]
 
                         _resolution = DAY;
@@ -159,26 +189,26 @@ namespace scidb4geo
             if ( _resolution == DAY ) {
                 if ( str[pos] == 'T' || str[pos] == ' ' ) ++pos;
                 if ( countNextDigits ( str, pos ) >= 2 ) {
-                    _hour = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                    _hour = parseDigits ( str, pos, 2, len );
                     pos += 2;
                     _resolution = HOUR;
-                    if ( str[pos] == ':' ) ++pos;
+                    if ( charAt ( str, pos, len ) == ':' ) ++pos;
                 }
                 if ( countNextDigits ( str, pos ) >= 2 ) {
-                    _minute = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                    _minute = parseDigits ( str, pos, 2, len );
                     pos += 2;
                     _resolution = MINUTE;
-                    if ( str[pos] == ':' ) ++pos;
+                    if ( charAt ( str, pos, len ) == ':' ) ++pos;
                 }
                 if ( countNextDigits ( str, pos ) >= 2 ) {
-                    _second = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                    _second = parseDigits ( str, pos, 2, len );
                     pos += 2;
                     _resolution = SECOND;
                 }
-                if ( str[pos] == '.' ) {
+                if ( charAt ( str, pos, len ) == '.' ) {
                     ++pos;
                     ndig = countNextDigits ( str, pos );
-                    _fraction = boost::lexical_cast<int> ( str.substr ( pos, ndig ) );
+                    _fraction = parseDigits ( str, pos, ndig, len );
                     pos += ndig;
                     _resolution = FRACTION;
                 }
@@ -194,32 +224,19 @@ namespace scidb4geo
                     _tz_hour = 0;
                     _tz_minute = 0;
                 }
-                else if ( str[pos] == '+' ) {
-                    ++pos;
-                    if ( countNextDigits ( str, pos ) == 2 ) {
-                        _tz_hour = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
-                        _tz_minute = 0;
-                        pos += 2;
-                        if ( str[pos] == ':' ) ++pos;
-                    }
-                    if ( countNextDigits ( str, pos ) == 2 ) {
-                        _tz_minute = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
-                        pos += 2;
-                    }
-                }
-                else if ( str[pos] == '-' ) {
+                else if ( str[pos] == '+' || str[pos] == '-' ) {
+                    int sign = ( str[pos] == '-' ) ? -1 : 1;
                     ++pos;
                     if ( countNextDigits ( str, pos ) == 2 ) {
-                        _tz_hour = -boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                        _tz_hour = sign * parseDigits ( str, pos, 2, len );
                         _tz_minute = 0;
                         pos += 2;
-                        if ( str[pos] == ':' ) ++pos;
+                        if ( charAt ( str, pos, len ) == ':' ) ++pos;
                     }
                     if ( countNextDigits ( str, pos ) == 2 ) {
-                        _tz_minute = boost::lexical_cast<int> ( str.substr ( pos, 2 ) );
+                        _tz_minute = parseDigits ( str, pos, 2, len );
                         pos += 2;
                     }
-
                 }
             }
         }
@@ -262,16 +279,19 @@ namespace scidb4geo
     string TPoint::toStringISO()
     {
         //return to_iso_extended_string(_pt);
-    
-        stringstream s;
-        if (this->_resolution >= YEAR) s << setw ( 4 ) << std::setfill ( '0' ) << _pt.date().year();
-        if (this->_resolution >= MONTH) s << "-" << setw ( 2 ) << std::setfill ( '0' ) << _pt.date().month().as_number();
-        if (this->_resolution >= DAY) s << "-" << setw ( 2 ) << std::setfill ( '0' ) << _pt.date().day().as_number();
-        if (this->_resolution >= HOUR) s << "T" << setw ( 2 ) << std::setfill ( '0' ) << _pt.time_of_day().hours();
-        if (this->_resolution >= MINUTE) s << ":" << setw ( 2 ) << std::setfill ( '0' ) << _pt.time_of_day().minutes();
-        if (this->_resolution >= SECOND) s << ":" << setw ( 2 ) << std::setfill ( '0' ) << _pt.time_of_day().seconds();
-        s.flush();
-        return s.str();
+
+        // formatted in place, called for every slice of SUBDATASETS and temporal ranges
+        char buf[32];
+        int n = 0;
+        date d = _pt.date();
+        time_duration tod = _pt.time_of_day();
+        if ( this->_resolution >= YEAR ) n += sprintf ( buf + n, "%04d", ( int ) d.year() );
+        if ( this->_resolution >= MONTH ) n += sprintf ( buf + n, "-%02d", ( int ) d.month().as_number() );
+        if ( this->_resolution >= DAY ) n += sprintf ( buf + n, "-%02d", ( int ) d.day().as_number() );
+        if ( this->_resolution >= HOUR ) n += sprintf ( buf + n, "T%02d", ( int ) tod.hours() );
+        if ( this->_resolution >= MINUTE ) n += sprintf ( buf + n, ":%02d", ( int ) tod.minutes() );
+        if ( this->_resolution >= SECOND ) n += sprintf ( buf + n, ":%02d", ( int ) tod.seconds() );
+        return string ( buf, n );
 
     }
 
@@ -325,18 +345,55 @@ namespace scidb4geo
 
 
 
-    TInterval::TInterval ( string str )
+    /**
+    * Parses a number as counted by countNextNumberChars in place, fails like boost::lexical_cast<float> would
+    */
+    static float parseNumber ( const string &s, int pos, int n )
     {
-        init();
-        boost::algorithm::trim ( str );
+        int end = pos + n;
+        float sign = 1;
+        if ( pos < end && ( s[pos] == '+' || s[pos] == '-' ) ) {
+            if ( s[pos] == '-' ) sign = -1;
+            ++pos;
+        }
+        double v = 0;
+        int ndig = 0;
+        while ( pos < end && isdigit ( ( unsigned char ) s[pos] ) ) {
+            v = v * 10 + ( s[pos++] - '0' );
+            ++ndig;
+        }
+        if ( pos < end ) {
+            if ( s[pos] != '.' ) throw boost::bad_lexical_cast();
+            ++pos;
+            double f = 0.1;
+            while ( pos < end ) {
+                v += f * ( s[pos++] - '0' );
+                f /= 10;
+                ++ndig;
+            }
+        }
+        if ( ndig == 0 ) throw boost::bad_lexical_cast();
+        return sign * ( float ) v;
+    }
 
 
-        vector<float>    numbers;
-        vector<char>   symbols;
+    TInterval::TInterval ( const string &str )
+    {
+        init();
+
+        // Intervals have at most one number per designator (Y,M,W,D,T,H,M,S)
+        float numbers[8];
+        char symbols[8];
+        int nnumbers = 0;
+        int nsymbols = 0;
         int pos = 0;
         int len = str.length();
         int first_time_index = -1;
 
+        // trim without copying
+        while ( pos < len && isspace ( ( unsigned char ) str[pos] ) ) ++pos;
+        while ( len > pos && isspace ( ( unsigned char ) str[len - 1] ) ) --len;
+
         if ( pos < len ) {
             if ( str[pos] == 'P' ) ++pos;
         }
@@ -348,7 +405,7 @@ namespace scidb4geo
                     // ERROR
                     break;
                 }
-                first_time_index = numbers.size(); //  elements of numvers and symbols with index >= first_time_index correspond to time
+                first_time_index = nnumbers; //  elements of numvers and symbols with index >= first_time_index correspond to time
                 ++pos;
 
             }
@@ -362,12 +419,12 @@ namespace scidb4geo
 //       else if (str[pos] == '+')++pos;
 
             int ndig = countNextNumberChars ( str, pos );
-            if ( ndig > 0 ) {
-                numbers.push_back ( boost::lexical_cast<float> ( str.substr ( pos, ndig ) ) );
+            if ( ndig > 0 && nnumbers < 8 ) {
+                numbers[nnumbers++] = parseNumber ( str, pos, ndig );
                 pos += ndig;
 
                 if ( pos < len ) {
-                    symbols.push_back ( str[pos++] );
+                    symbols[nsymbols++] = str[pos++];
                 }
             } // TODO: Support fractional seconds, add T separator
             else break;
@@ -377,7 +434,7 @@ namespace scidb4geo
 
 
 
-        int l = ( symbols.size() < numbers.size() ) ? symbols.size() : numbers.size();
+        int l = ( nsymbols < nnumbers ) ? nsymbols : nnumbers;
         if ( l == 0 ) {
             // ERROR
         }
@@ -539,15 +596,39 @@ namespace scidb4geo
         _t0 = new TPoint ( );
         _dt = new TInterval ( );
         _r = _dt->_resolution;
+        _tab_first = 0;
     }
     
-    TReference::TReference ( string t0text, string dttext ) : _t0 ( NULL ), _dt ( NULL )
+    TReference::TReference ( string t0text, string dttext ) : _t0 ( NULL ), _dt ( NULL ), _tab_first ( 0 )
     {
         _t0 = new TPoint ( t0text );
         _dt = new TInterval ( dttext );
         _r = _dt->_resolution;
     }
 
+    TReference::TReference ( const TReference& other ) : _t0 ( NULL ), _dt ( NULL ), _r ( other._r ),
+        _tab ( other._tab ), _tabkeys ( other._tabkeys ), _tab_first ( other._tab_first )
+    {
+        if ( other._t0 != NULL ) _t0 = new TPoint ( *other._t0 );
+        if ( other._dt != NULL ) _dt = new TInterval ( *other._dt );
+    }
+
+    TReference& TReference::operator= ( const TReference& other )
+    {
+        if ( this == &other ) return *this;
+        TPoint* t0 = ( other._t0 != NULL ) ? new TPoint ( *other._t0 ) : NULL;
+        TInterval* dt = ( other._dt != NULL ) ? new TInterval ( *other._dt ) : NULL;
+        if ( _t0 != NULL ) delete _t0;
+        if ( _dt != NULL ) delete _dt;
+        _t0 = t0;
+        _dt = dt;
+        _r = other._r;
+        _tab = other._tab;
+        _tabkeys = other._tabkeys;
+        _tab_first = other._tab_first;
+        return *this;
+    }
+
 
     TReference::~TReference( )
     {
@@ -572,63 +653,180 @@ namespace scidb4geo
 
 
 
-    TPoint TReference::datetimeAtIndex ( int index )
+    int TReference::calendarKey ( const ptime &p )
     {
-        return *_t0 + index * *_dt;
+        int key = p.date().year() * 12;
+        if ( _r == MONTH ) key += p.date().month() - 1;
+        return key;
     }
 
 
 
-    int TReference::indexAtDatetime ( TPoint &t )
+    bool TReference::extendTable ( int first, int last )
     {
-        TInterval dif;
+        if ( _dt->_yd == 0 && _dt->_md == 0 ) return false;
+        if ( last < first ) return true;
+
+        int n = ( int ) _tab.size();
+        int lo = ( n > 0 ) ? min ( first, _tab_first ) : first;
+        int hi = ( n > 0 ) ? max ( last, _tab_first + n - 1 ) : last;
+        if ( n > 0 && lo == _tab_first && hi == _tab_first + n - 1 ) return true;
+        if ( ( int64_t ) hi - lo + 1 > TREFERENCE_MAX_TABLESIZE ) return false;
+
+        // grow geometrically so that sequential access does not rebuild the table for every index
+        int glo = lo;
+        int ghi = hi;
+        if ( n > 0 ) {
+            if ( lo < _tab_first ) glo = min ( lo, _tab_first - n );
+            if ( hi > _tab_first + n - 1 ) ghi = max ( hi, _tab_first + 2 * n - 1 );
+            if ( ( int64_t ) ghi - glo + 1 > TREFERENCE_MAX_TABLESIZE ) {
+                glo = lo;
+                ghi = hi;
+            }
+        }
 
-        if ( _r == YEAR ) {
-            dif._yd = t._pt.date().year() - _t0->_pt.date().year();
+        try {
+            extendTableTo ( glo, ghi );
         }
-        else if ( _r == MONTH ) {
-            dif._yd = t._pt.date().year() - _t0->_pt.date().year();
-            dif._md = t._pt.date().month() - _t0->_pt.date().month();
-            while ( dif._md < 0 ) {
-                dif._md += 12;
-                dif._yd -= 1;
+        catch ( std::out_of_range & ) {
+            // the grown range leaves the supported calendar, only add what has been asked for
+            if ( glo == lo && ghi == hi ) return false;
+            try {
+                extendTableTo ( lo, hi );
             }
-            while ( dif._md >= 12 ) {
-                dif._md -= 12;
-                dif._yd += 1;
+            catch ( std::out_of_range & ) {
+                return false;
             }
         }
-        // TODO: Week
-        else if ( _r == DAY ) {
-            dif._dd = t._pt.date() - _t0->_pt.date();
+        return true;
+    }
+
+
+
+    void TReference::extendTableTo ( int lo, int hi )
+    {
+        int n = ( int ) _tab.size();
+        int front_end = ( n > 0 ) ? _tab_first : hi + 1;
+        int back_begin = ( n > 0 ) ? _tab_first + n : hi + 1;
+
+        // each entry is computed from t0, adding intervals repeatedly would drift at month ends
+        vector<ptime> front, back;
+        for ( int i = lo; i < front_end; ++i ) front.push_back ( ( *_t0 + i * *_dt )._pt );
+        for ( int i = back_begin; i <= hi; ++i ) back.push_back ( ( *_t0 + i * *_dt )._pt );
+
+        vector<int> frontkeys, backkeys;
+        for ( size_t i = 0; i < front.size(); ++i ) frontkeys.push_back ( calendarKey ( front[i] ) );
+        for ( size_t i = 0; i < back.size(); ++i ) backkeys.push_back ( calendarKey ( back[i] ) );
+
+        _tab.insert ( _tab.begin(), front.begin(), front.end() );
+        _tab.insert ( _tab.end(), back.begin(), back.end() );
+        _tabkeys.insert ( _tabkeys.begin(), frontkeys.begin(), frontkeys.end() );
+        _tabkeys.insert ( _tabkeys.end(), backkeys.begin(), backkeys.end() );
+        _tab_first = lo;
+    }
+
+
+
+    void TReference::precomputeIndexTable ( int first, int last )
+    {
+        extendTable ( first, last );
+    }
+
+
+
+    TPoint TReference::datetimeAtIndex ( int index )
+    {
+        if ( _dt->_yd != 0 || _dt->_md != 0 ) {
+            if ( !extendTable ( index, index ) ) return *_t0 + index * *_dt;
+            TPoint res = *_t0;
+            res._pt = _tab[index - _tab_first];
+            return res;
         }
-        else if ( _r >= HOUR ) {
-            dif._td = t._pt - _t0->_pt;
+
+        // Fixed length cells, closed form without building an intermediate interval
+        TPoint res = *_t0;
+        res._pt += date_duration ( ( long ) index * _dt->_dd.days() );
+        res._pt += _dt->_td * index;
+        return res;
+    }
+
+
+
+    void TReference::datetimesAtIndexRange ( int first, int last, vector<TPoint> &out )
+    {
+        out.clear();
+        if ( last < first ) return;
+        out.reserve ( last - first + 1 );
+
+        if ( _dt->_yd != 0 || _dt->_md != 0 ) {
+            // Calendar arithmetic, months do not have a fixed length
+            if ( extendTable ( first, last ) ) {
+                TPoint res = *_t0;
+                for ( int i = first; i <= last; ++i ) {
+                    res._pt = _tab[i - _tab_first];
+                    out.push_back ( res );
+                }
+            }
+            else {
+                for ( int i = first; i <= last; ++i ) out.push_back ( *_t0 + i * *_dt );
+            }
+            return;
         }
 
-    
-        double result;
-    
-        //TODO check if difference == 0 conditions are necessary
-        double ym;
-        // if ( ( _dt->_yd * 12 + _dt->_md ) == 0 ) ym = NAN;
-        if ( ( _dt->_yd * 12 + _dt->_md ) == 0 ) ym = 0;
-        else ym = ( dif._yd * 12 + dif._md ) / ( _dt->_yd * 12 + _dt->_md );
-        double d;
-        //  if ( _dt->_dd.days() == 0 ) d = NAN;
-        if ( _dt->_dd.days() == 0 ) d = 0;
-        else d = dif._dd.days() / _dt->_dd.days();
-        double tt;
-        //  if ( _dt->_td.total_seconds() == 0 ) tt = NAN;
-        if ( _dt->_td.total_seconds() == 0) tt = 0;
-        else tt = dif._td.total_seconds() / _dt->_td.total_seconds(); // TODO: Fractional seconds?
-
-        if ( _r < DAY ) result =  ym;
-        else if ( _r == DAY ) result =  d;
-        else result =  tt;
-
-        return ( int ) result;
+        // Fixed length cells, step forward from the first point
+        TPoint cur = datetimeAtIndex ( first );
+        time_duration step = hours ( 24 * _dt->_dd.days() ) + _dt->_td;
+        for ( int i = first; i <= last; ++i ) {
+            out.push_back ( cur );
+            cur._pt += step;
+        }
+    }
+
+
+
+    void TReference::indexesAtDatetimes ( vector<TPoint> &t, vector<int> &out )
+    {
+        out.resize ( t.size() );
+        for ( size_t i = 0; i < t.size(); ++i ) out[i] = indexAtDatetime ( t[i] );
+    }
+
+
 
+    int TReference::indexAtDatetime ( TPoint &t )
+    {
+        // Only the component matching the resolution contributes, integer division truncates towards zero
+        if ( _r < DAY ) {
+            int64_t dym = ( int64_t ) _dt->_yd * 12 + _dt->_md;
+
+            // Search the precomputed table if its keys advance by exactly one cellsize per index
+            if ( !_tabkeys.empty() && ( _r == MONTH || ( _r == YEAR && dym % 12 == 0 ) ) ) {
+                int k = calendarKey ( t._pt );
+                if ( k >= _tabkeys.front() && k <= _tabkeys.back() ) {
+                    vector<int>::iterator it;
+                    if ( k >= calendarKey ( _t0->_pt ) ) it = upper_bound ( _tabkeys.begin(), _tabkeys.end(), k ) - 1; // last cell starting at or before t
+                    else it = lower_bound ( _tabkeys.begin(), _tabkeys.end(), k ); // towards zero as for the closed form
+                    return _tab_first + ( int ) ( it - _tabkeys.begin() );
+                }
+            }
+
+            int64_t ym = 0;
+            if ( _r == YEAR || _r == MONTH ) {
+                ym = ( int64_t ) ( t._pt.date().year() - _t0->_pt.date().year() ) * 12;
+                if ( _r == MONTH ) ym += ( int64_t ) t._pt.date().month() - ( int64_t ) _t0->_pt.date().month();
+            }
+            if ( dym == 0 ) return 0;
+            return ( int ) ( ym / dym );
+        }
+        else if ( _r == DAY ) {
+            int64_t dd = _dt->_dd.days();
+            if ( dd == 0 ) return 0;
+            return ( int ) ( ( int64_t ) ( t._pt.date() - _t0->_pt.date() ).days() / dd );
+        }
+        else {
+            int64_t dts = _dt->_td.total_seconds(); // TODO: Fractional seconds?
+            if ( dts == 0 ) return 0;
+            return ( int ) ( ( int64_t ) ( t._pt - _t0->_pt ).total_seconds() / dts );
+        }
     }
 
 }
@@ -21,11 +21,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <sstream>
 #include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+/**
+* Maximum number of precomputed datetimes per temporal reference with a monthly or yearly cellsize
+*/
+#define TREFERENCE_MAX_TABLESIZE 65536
+
 namespace scidb4geo {
 
     using namespace std;
@@ -88,7 +94,7 @@ namespace scidb4geo {
         *
         * @param str ISO 8601 string
         **/
-        TPoint(string str);
+        TPoint(const string& str);
 
         /**
         * @brief creates a string representation
@@ -176,7 +182,7 @@ namespace scidb4geo {
         *
         * @param str ISO 8601 string
         */
-        TInterval(string str);
+        TInterval(const string& str);
 
         /**
         * Duration given as number of months. Months vary in its number of days.
@@ -238,6 +244,14 @@ namespace scidb4geo {
         **/
         TReference(string t0text, string dttext);
         TReference();
+        /**
+        * @brief Copy constructor, duplicates the temporal datum and cellsize
+        */
+        TReference(const TReference& other);
+        /**
+        * @brief Assignment, duplicates the temporal datum and cellsize
+        */
+        TReference& operator=(const TReference& other);
         ~TReference();
 
         /**
@@ -279,6 +293,40 @@ namespace scidb4geo {
         */
         int indexAtDatetime(TPoint& t);
 
+        /**
+        * @brief Returns the date/times of all indexes in [first,last]
+        *
+        * Batch version of datetimeAtIndex(). For cellsizes of fixed length (days, hours, minutes, seconds), points
+        * are computed by stepping from the first point instead of evaluating each index separately.
+        *
+        * @param first first index on the temporal dimension
+        * @param last last index on the temporal dimension (inclusive)
+        * @param out resulting temporal points, last - first + 1 elements
+        */
+        void datetimesAtIndexRange(int first, int last, vector<TPoint>& out);
+
+        /**
+        * @brief Returns the indexes of several date/times
+        *
+        * Batch version of indexAtDatetime().
+        *
+        * @param t temporal points
+        * @param out resulting indexes, one per element of t
+        */
+        void indexesAtDatetimes(vector<TPoint>& t, vector<int>& out);
+
+        /**
+        * @brief Precomputes the date/times of all indexes in [first,last]
+        *
+        * Only has an effect for monthly or yearly cellsizes, where each index otherwise needs calendar arithmetic.
+        * The table is extended lazily by datetimeAtIndex() and datetimesAtIndexRange() and is searched by
+        * indexAtDatetime(). Ranges longer than TREFERENCE_MAX_TABLESIZE are not tabulated.
+        *
+        * @param first first index on the temporal dimension, usually the lower bound of the array
+        * @param last last index on the temporal dimension, usually the upper bound of the array
+        */
+        void precomputeIndexTable(int first, int last);
+
     protected:
         /** the temporal datum */
         TPoint* _t0;
@@ -286,6 +334,33 @@ namespace scidb4geo {
         TInterval* _dt;
         /** the  temporal resolution (informal) */
         TResolution _r;
+
+        /** date/times of the indexes _tab_first, _tab_first + 1, ... (monthly or yearly cellsizes only) */
+        vector<boost::posix_time::ptime> _tab;
+        /** calendar keys of _tab in ascending order, see calendarKey() */
+        vector<int> _tabkeys;
+        /** the index of the first entry in _tab */
+        int _tab_first;
+
+    private:
+        /**
+        * @brief Makes sure that _tab covers [first,last], grows by at least the current table size
+        *
+        * @return false if the cellsize has a fixed length or the table would become too large
+        */
+        bool extendTable(int first, int last);
+
+        /**
+        * @brief Computes the missing entries of _tab for [lo,hi], leaves the table unchanged on failure
+        *
+        * @throws std::out_of_range if a date/time is outside the supported calendar
+        */
+        void extendTableTo(int lo, int hi);
+
+        /**
+        * @brief Number of months since year 0, truncated to full years for a yearly resolution
+        */
+        int calendarKey(const boost::posix_time::ptime& p);
     };
 }
 
@@ -0,0 +1,93 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#include "arraydesccache.h"
+#include <sstream>
+#include "cpl_multiproc.h"
+
+namespace scidb4gdal {
+
+    /**
+    * A cached descriptor and the version of the array it describes
+    */
+    struct ArrayDescCacheEntry {
+        SciDBSpatialArray* array;
+        string version;
+    };
+
+    static CPLMutex* hArrayDescCacheMutex = NULL;
+    static map<string, ArrayDescCacheEntry> arrayDescCache;
+    /** order of insertions for removing oldest first */
+    static list<string> arrayDescCacheQ;
+
+    string ArrayDescCache::key(const ConnectionParameters& con, const string& arrayname) {
+        stringstream s;
+        s << con.host << "|" << con.port << "|" << con.user << "|" << arrayname;
+        return s.str();
+    }
+
+    SciDBSpatialArray* ArrayDescCache::get(const ConnectionParameters& con, const string& arrayname, const string& version) {
+        CPLMutexHolderD(&hArrayDescCacheMutex);
+        map<string, ArrayDescCacheEntry>::iterator it = arrayDescCache.find(key(con, arrayname));
+        if (it == arrayDescCache.end() || it->second.version != version) return NULL;
+        return it->second.array->clone();
+    }
+
+    void ArrayDescCache::put(const ConnectionParameters& con, SciDBSpatialArray& array, const string& version) {
+        string k = key(con, array.name);
+        ArrayDescCacheEntry entry;
+        entry.array = array.clone();
+        entry.version = version;
+
+        CPLMutexHolderD(&hArrayDescCacheMutex);
+        map<string, ArrayDescCacheEntry>::iterator it = arrayDescCache.find(k);
+        if (it != arrayDescCache.end()) {
+            delete it->second.array;
+            it->second = entry;
+            return;
+        }
+        while (arrayDescCacheQ.size() >= SCIDB4GDAL_MAXARRAYDESCCACHE) {
+            it = arrayDescCache.find(arrayDescCacheQ.front());
+            if (it != arrayDescCache.end()) {
+                delete it->second.array;
+                arrayDescCache.erase(it);
+            }
+            arrayDescCacheQ.pop_front();
+        }
+        arrayDescCache.insert(pair<string, ArrayDescCacheEntry>(k, entry));
+        arrayDescCacheQ.push_back(k);
+    }
+
+    void ArrayDescCache::remove(const ConnectionParameters& con, const string& arrayname) {
+        string k = key(con, arrayname);
+
+        CPLMutexHolderD(&hArrayDescCacheMutex);
+        map<string, ArrayDescCacheEntry>::iterator it = arrayDescCache.find(k);
+        if (it != arrayDescCache.end()) {
+            delete it->second.array;
+            arrayDescCache.erase(it);
+            arrayDescCacheQ.remove(k);
+        }
+    }
+}
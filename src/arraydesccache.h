@@ -0,0 +1,83 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#ifndef ARRAYDESCCACHE_H
+#define ARRAYDESCCACHE_H
+
+#include <list>
+#include <map>
+#include <string>
+#include "scidb_structs.h"
+#include "shim_client_structs.h"
+#include "tilecache.h"
+
+#define SCIDB4GDAL_MAXARRAYDESCCACHE 32
+
+namespace scidb4gdal {
+    using namespace std;
+
+    /**
+    * @brief A process-wide cache of array descriptors
+    *
+    * Opening a temporal slice of a spatio-temporal array (e.g. one of the SUBDATASETS) needs exactly the same schema, spatial and temporal reference
+    * as the full array. This cache keeps a copy of the descriptors of arrays of recently opened slices, so that consecutive opens of slices do not need to
+    * query the server again. Entries are identified by host, port, user and array name and are dropped whenever the array is overwritten or deleted
+    * by the driver. Entries are only used for the version of the array they have been fetched for, see ShimClient::getArrayVersion(), such that
+    * modifications by other writers, e.g. new temporal slices, are taken into account.
+    */
+    class ArrayDescCache {
+    public:
+        /**
+        * @brief Fetches a copy of a cached array descriptor
+        * @param con the connection parameters of the requesting dataset
+        * @param arrayname the name of the array (without any slicing expression)
+        * @param version the current version token of the array
+        * @return a newly allocated copy of the descriptor which is owned by the caller, or NULL if the version of the array is not cached
+        */
+        static SciDBSpatialArray* get(const ConnectionParameters& con, const string& arrayname, const string& version);
+
+        /**
+        * @brief Stores a copy of an array descriptor, replacing an existing entry
+        * @param con the connection parameters that were used to fetch the descriptor
+        * @param array the descriptor to be cached
+        * @param version the version token of the array, fetched before the descriptor
+        */
+        static void put(const ConnectionParameters& con, SciDBSpatialArray& array, const string& version);
+
+        /**
+        * @brief Drops a cached array descriptor, e.g. after the array has been modified
+        * @param con the connection parameters of the modifying operation
+        * @param arrayname the name of the array
+        */
+        static void remove(const ConnectionParameters& con, const string& arrayname);
+
+    private:
+        /**
+        * @brief Derives the key of an array on a specific server
+        */
+        static string key(const ConnectionParameters& con, const string& arrayname);
+    };
+}
+
+#endif
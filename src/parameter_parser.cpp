@@ -48,6 +48,22 @@ namespace scidb4gdal {
         _propKeyResolver.mapping.insert(std::pair<string, Properties>("chunksize_sp", CHUNKSIZE_SPATIAL));
         _propKeyResolver.mapping.insert(std::pair<string, Properties>("CHUNKSIZE_T", CHUNKSIZE_TEMPORAL));
         _propKeyResolver.mapping.insert(std::pair<string, Properties>("chunksize_t", CHUNKSIZE_TEMPORAL));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("REDUCE", REDUCE));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("reduce", REDUCE));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("BATCH", BATCH));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("batch", BATCH));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("FLUSH", FLUSH));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("flush", FLUSH));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("SOURCES", SOURCES));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("sources", SOURCES));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("STATS_SAMPLE", STATS_SAMPLE));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("stats_sample", STATS_SAMPLE));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("DENSE_THRESHOLD", DENSE_THRESHOLD));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("dense_threshold", DENSE_THRESHOLD));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("READ_STRATEGY", READ_STRATEGY));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("read_strategy", READ_STRATEGY));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("HISTOGRAM", HISTOGRAM));
+        _propKeyResolver.mapping.insert(std::pair<string, Properties>("histogram", HISTOGRAM));
 
         // 2016-11-17: VC++ 2013 complains about ambigous = operator with map_list_of()
         //_conKeyResolver.mapping = map_list_of("host", HOST)("port", PORT)(
@@ -260,33 +276,7 @@ namespace scidb4gdal {
             // 	    }
 
             if (t_interval.length() > 0) {
-                // if string is a timestamp then translate it into the temporal index
-                if (Utils::validateTimestampString(t_interval)) {
-                    // store timestamp for query when calling scidb
-                    _query->timestamp = t_interval;
-                    _query->hasTemporalIndex = false;
-                } else {
-                    // simply extract the temporal index
-                    size_t pos = t_interval.find(":");
-                    if (pos < t_interval.length()) {
-                        // interval
-                        vector<string> attr;
-                        boost::split(attr, t_interval, boost::is_any_of(":"));
-                        _query->lower_bound = boost::lexical_cast<int>(attr[0]);
-                        _query->upper_bound = boost::lexical_cast<int>(attr[1]);
-                        // TODO for now we parse it correctly, but we will just use the
-                        // lower_bound... change this later
-                        Utils::debug("Currently interval query is not supported. Using the "
-                                     "lower bound instead");
-                        _query->temp_index = _query->lower_bound;
-                    } else {
-                        // temporal index
-                        _query->temp_index = boost::lexical_cast<int>(t_interval);
-                    }
-                    if (_query->temp_index > 0) {
-                        _query->hasTemporalIndex = true;
-                    }
-                }
+                parseTemporalExpression(t_interval);
             } else {
                 Utils::error("No temporal information stated");
                 return;
@@ -294,6 +284,49 @@ namespace scidb4gdal {
         }
     }
 
+    void ParameterParser::parseTemporalExpression(string expr) {
+        boost::algorithm::trim(expr);
+        // dates may use '/' as divider themselves, the interval separator follows the first date
+        size_t pos = (expr.length() > 10) ? expr.find("/", 10) : string::npos;
+        if (pos != string::npos) {
+            // ISO 8601 time interval
+            _query->timestamp = expr.substr(0, pos);
+            _query->timestamp_end = expr.substr(pos + 1);
+            if (_query->timestamp_end.length() < 10 ||
+                !Utils::validateTimestampString(_query->timestamp) ||
+                !Utils::validateTimestampString(_query->timestamp_end)) {
+                Utils::error("Invalid temporal interval '" + expr + "'");
+                throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+            }
+            _query->hasTemporalRange = true;
+            _query->hasTemporalIndex = false;
+            return;
+        }
+        // if string is a timestamp then translate it into the temporal index later
+        if (expr.length() >= 10 && Utils::validateTimestampString(expr)) {
+            _query->timestamp = expr;
+            _query->hasTemporalIndex = false;
+            return;
+        }
+        try {
+            pos = expr.find(":");
+            if (pos != string::npos) {
+                // index interval
+                _query->lower_bound = boost::lexical_cast<int>(expr.substr(0, pos));
+                _query->upper_bound = boost::lexical_cast<int>(expr.substr(pos + 1));
+                _query->hasTemporalRange = true;
+                _query->hasTemporalIndex = false;
+            } else {
+                // temporal index, 0 is a valid slice, too
+                _query->temp_index = boost::lexical_cast<int>(expr);
+                _query->hasTemporalIndex = true;
+            }
+        } catch (boost::bad_lexical_cast&) {
+            Utils::error("Invalid temporal selection '" + expr + "'");
+            throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+        }
+    }
+
     ConnectionParameters& ParameterParser::getConnectionParameters() {
         return *_con;
     }
@@ -467,7 +500,7 @@ namespace scidb4gdal {
             case CHUNKSIZE_SPATIAL:
                 try {
                     _create->chunksize_spatial = boost::lexical_cast<int>(value);
-                } catch (boost::bad_lexical_cast e) {
+                } catch (boost::bad_lexical_cast& e) {
                     Utils::debug(e.what());
                     throw ERR_GLOBAL_PARSE;
                 }
@@ -475,11 +508,23 @@ namespace scidb4gdal {
             case CHUNKSIZE_TEMPORAL:
                 try {
                     _create->chunksize_temporal = boost::lexical_cast<int>(value);
-                } catch (boost::bad_lexical_cast e) {
+                } catch (boost::bad_lexical_cast& e) {
                     Utils::debug(e.what());
                     throw ERR_GLOBAL_PARSE;
                 }
                 break;
+            case BATCH:
+                _create->batch = CSLTestBoolean(value.c_str());
+                break;
+            case FLUSH:
+                _create->flush = CSLTestBoolean(value.c_str());
+                break;
+            case SOURCES:
+                _create->sources = value;
+                break;
+            case HISTOGRAM:
+                _create->histogram = CSLTestBoolean(value.c_str());
+                break;
         }
     }
 
@@ -487,15 +532,68 @@ namespace scidb4gdal {
         Properties enumKey = _propKeyResolver.getKey(key);
         switch (enumKey) {
             case T_INDEX:
+            case TIMESTAMP:
                 // this T_INDEX is for query only!
-                Utils::debug("Assign query parameter for temporal index");
-                _query->temp_index = boost::lexical_cast<int>(value);
-                _query->hasTemporalIndex = true;
-                // TODO maybe we allow also selecting multiple slices (that will later be
-                // saved separately as individual files)
+                Utils::debug("Assign query parameter for temporal selection");
+                parseTemporalExpression(value);
+                break;
+            case REDUCE:
+                parseReductions(value);
                 break;
+            case STATS_SAMPLE:
+                try {
+                    _query->stats_sample = boost::lexical_cast<double>(boost::algorithm::trim_copy(value));
+                } catch (boost::bad_lexical_cast&) {
+                    _query->stats_sample = -1;
+                }
+                if (!(_query->stats_sample > 0 && _query->stats_sample <= 1)) {
+                    Utils::error("Invalid value '" + value + "' of option stats_sample, use a sampling rate in (0,1]");
+                    throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+                }
+                break;
+            case DENSE_THRESHOLD:
+                try {
+                    _query->dense_threshold = boost::lexical_cast<double>(boost::algorithm::trim_copy(value));
+                } catch (boost::bad_lexical_cast&) {
+                    _query->dense_threshold = -1;
+                }
+                if (!(_query->dense_threshold >= 0 && _query->dense_threshold <= 1)) {
+                    Utils::error("Invalid value '" + value + "' of option dense_threshold, use a number in [0,1]");
+                    throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+                }
+                break;
+            case READ_STRATEGY: {
+                string strategy = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(value));
+                if (strategy == "auto")
+                    _query->read_strategy = READ_AUTO;
+                else if (strategy == "subarray")
+                    _query->read_strategy = READ_SUBARRAY;
+                else if (strategy == "between")
+                    _query->read_strategy = READ_BETWEEN;
+                else {
+                    Utils::error("Invalid value '" + value + "' of option read_strategy, use auto, subarray, or between");
+                    throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+                }
+                break;
+            }
             default:
                 break;
         }
     }
+
+    void ParameterParser::parseReductions(string list) {
+        vector<string> ops;
+        boost::split(ops, list, boost::is_any_of(","));
+        _query->reductions.clear();
+        for (vector<string>::iterator it = ops.begin(); it != ops.end(); ++it) {
+            string op = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(*it));
+            if (op == "avg") op = "mean";
+            if (op == "count-valid") op = "count";
+            if (op != "mean" && op != "min" && op != "max" && op != "count") {
+                Utils::error("Unknown temporal reduction '" + *it + "', use mean, min, max or count");
+                throw (int) ERR_GLOBAL_INVALIDOPTION; // caught by SciDBDataset::Open()
+            }
+            _query->reductions.push_back(op);
+        }
+    }
 }
@@ -177,6 +177,27 @@ namespace scidb4gdal
          */
         void parseSlicedArrayName();
 
+        /**
+         * @brief parses a temporal selection into the query parameters
+         *
+         * The expression is either a temporal index ("5"), an index interval ("10:40"), an ISO 8601 date/time ("2016-01-01") or an
+         * ISO 8601 time interval given by start and end ("2016-01-01/2016-03-01"). Intervals include both boundaries.
+         *
+         * @param expr the temporal expression
+         * @return void
+         */
+        void parseTemporalExpression(string expr);
+
+        /**
+         * @brief parses a comma separated list of temporal reductions into the query parameters
+         *
+         * Valid reductions are "mean" (or "avg"), "min", "max" and "count" (or "count-valid").
+         *
+         * @param list the list of reductions
+         * @return void
+         */
+        void parseReductions(string list);
+
 
 
         /**
@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#include "readahead.h"
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include "cpl_conv.h"
+#include "cpl_multiproc.h"
+
+namespace scidb4gdal {
+
+    /**
+    * Accessed and buffered slices of a window
+    */
+    struct ReadAheadEntry {
+        /** temporal index that has been accessed last */
+        int64_t last;
+        /** temporal index of the first buffered slice */
+        int64_t t0;
+        /** size of one slice in bytes */
+        size_t size;
+        /** buffered slices */
+        string data;
+        /** position in the access order */
+        list<string>::iterator lru;
+
+        ReadAheadEntry() : last(-1), t0(0), size(0), data("") {}
+    };
+
+    static CPLMutex* hReadAheadMutex = NULL;
+    static map<string, ReadAheadEntry> readAhead;
+    /** order of accesses for removing least recently used windows first */
+    static list<string> readAheadLRU;
+    /** size of all buffered slices in bytes */
+    static size_t readAheadBytes = 0;
+
+    /**
+    * Removes a window (the mutex must be held)
+    */
+    static void readAheadErase(map<string, ReadAheadEntry>::iterator it) {
+        readAheadBytes -= it->second.data.size();
+        readAheadLRU.erase(it->second.lru);
+        readAhead.erase(it);
+    }
+
+    /**
+    * Removes least recently used windows until the limits are met, except for the given window (the mutex must be held)
+    */
+    static void readAheadEvict(const string& keep) {
+        const size_t budget = ReadAhead::budget();
+        while (!readAheadLRU.empty() && (readAhead.size() > SCIDB4GDAL_MAXREADAHEAD || readAheadBytes > budget)) {
+            if (readAheadLRU.front() == keep) {
+                // all other windows are gone, the slices of this window alone exceed the budget and are not buffered
+                ReadAheadEntry& e = readAhead[keep];
+                readAheadBytes -= e.data.size();
+                e.data.clear();
+                break;
+            }
+            readAheadErase(readAhead.find(readAheadLRU.front()));
+        }
+    }
+
+    /**
+    * Returns the entry of a window, creating it if needed, and marks it as used most recently (the mutex must be held)
+    */
+    static ReadAheadEntry& readAheadEntry(const string& key) {
+        map<string, ReadAheadEntry>::iterator it = readAhead.find(key);
+        if (it != readAhead.end()) {
+            readAheadLRU.splice(readAheadLRU.end(), readAheadLRU, it->second.lru);
+            return it->second;
+        }
+        ReadAheadEntry& e = readAhead[key];
+        e.lru = readAheadLRU.insert(readAheadLRU.end(), key);
+        readAheadEvict(key);
+        return e;
+    }
+
+    size_t ReadAhead::budget() {
+        const char* mb = CPLGetConfigOption("SCIDB4GDAL_READAHEAD_MB", NULL);
+        int n = (mb != NULL) ? atoi(mb) : SCIDB4GDAL_READAHEAD_MB;
+        return (n > 0) ? (size_t) n * 1024 * 1024 : 0;
+    }
+
+    string ReadAhead::arrayKey(const ConnectionParameters& con, const string& arrayname, const string& version) {
+        stringstream s;
+        s << con.host << "|" << con.port << "|" << con.user << "|" << arrayname << "|" << version;
+        return s.str();
+    }
+
+    string ReadAhead::key(const string& arraykey, int attr,
+                          int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max) {
+        stringstream s;
+        s << arraykey << "|" << attr << "|" << x_min << "|" << y_min << "|" << x_max << "|" << y_max;
+        return s.str();
+    }
+
+    bool ReadAhead::get(const string& key, int64_t t, void* out, size_t size) {
+        CPLMutexHolderD(&hReadAheadMutex);
+        map<string, ReadAheadEntry>::iterator it = readAhead.find(key);
+        if (it == readAhead.end()) return false;
+        ReadAheadEntry& e = it->second;
+        if (e.size != size || t < e.t0 || (size_t) (t - e.t0) >= e.data.size() / size) return false;
+        memcpy(out, e.data.data() + (size_t) (t - e.t0) * size, size);
+        e.last = t;
+        // access is sequential, slices up to t are not needed anymore
+        e.data.erase(0, (size_t) (t - e.t0 + 1) * size);
+        readAheadBytes -= (size_t) (t - e.t0 + 1) * size;
+        e.t0 = t + 1;
+        readAheadLRU.splice(readAheadLRU.end(), readAheadLRU, e.lru);
+        return true;
+    }
+
+    bool ReadAhead::sequential(const string& key, int64_t t) {
+        CPLMutexHolderD(&hReadAheadMutex);
+        ReadAheadEntry& e = readAheadEntry(key);
+        bool seq = (e.last >= 0 && e.last == t - 1);
+        e.last = t;
+        return seq;
+    }
+
+    void ReadAhead::put(const string& key, int64_t t0, const void* data, size_t size, size_t n) {
+        CPLMutexHolderD(&hReadAheadMutex);
+        ReadAheadEntry& e = readAheadEntry(key);
+        readAheadBytes -= e.data.size();
+        e.t0 = t0;
+        e.size = size;
+        e.data.assign((const char*) data, size * n);
+        readAheadBytes += e.data.size();
+        readAheadEvict(key);
+    }
+
+    void ReadAhead::remove(const ConnectionParameters& con, const string& arrayname) {
+        // keys of all versions of the array start with the key of its empty version
+        const string prefix = arrayKey(con, arrayname, "");
+
+        CPLMutexHolderD(&hReadAheadMutex);
+        map<string, ReadAheadEntry>::iterator it = readAhead.lower_bound(prefix);
+        while (it != readAhead.end() && it->first.compare(0, prefix.length(), prefix) == 0)
+            readAheadErase(it++);
+    }
+}
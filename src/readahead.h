@@ -0,0 +1,118 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#ifndef READAHEAD_H
+#define READAHEAD_H
+
+#include <list>
+#include <map>
+#include <string>
+#include <inttypes.h>
+#include "shim_client_structs.h"
+
+#define SCIDB4GDAL_MAXREADAHEAD 256 // number of windows for which temporal access is tracked
+#define SCIDB4GDAL_READAHEAD_MB 64 // default memory budget of buffered slices, see the SCIDB4GDAL_READAHEAD_MB configuration option
+#define SCIDB4GDAL_READAHEAD_MINSLICES 4 // minimum number of slices fetched at once, if the temporal chunk size is smaller
+
+namespace scidb4gdal {
+    using namespace std;
+
+    /**
+    * @brief A process-wide read-ahead buffer for sequential access to temporal slices
+    *
+    * Jobs that iterate over a spatio-temporal array slice by slice open one dataset per slice and read the same windows from each of them.
+    * This class tracks the temporal index that has been read last for each window of an attribute. Once a window is read at the temporal index
+    * that follows the previous one, the dataset fetches the following slices with a single three-dimensional query and stores them here, such that
+    * datasets of the next slices are served without contacting the server. Windows are identified by the array key (host, port, user, array name
+    * and array version), the attribute and the spatial boundaries. Datasets opened after the array has been modified by any writer hence never see
+    * slices buffered before; buffered slices are dropped as well whenever the array is overwritten or deleted by the driver.
+    *
+    * Buffered slices are limited to SCIDB4GDAL_READAHEAD_MB megabytes (configuration option of the same name, 0 disables buffering), windows
+    * that have not been accessed for the longest time are dropped first.
+    */
+    class ReadAhead {
+    public:
+        /**
+        * @brief Returns the memory budget of buffered slices in bytes, 0 if read-ahead is disabled
+        */
+        static size_t budget();
+
+        /**
+        * @brief Derives the key of a version of an array on a specific server
+        * @param con the connection parameters of the dataset
+        * @param arrayname the name of the array (without any slicing expression)
+        * @param version version token of the array, see ShimClient::getArrayVersion()
+        */
+        static string arrayKey(const ConnectionParameters& con, const string& arrayname, const string& version);
+
+        /**
+        * @brief Derives the key of a window of an attribute
+        * @param arraykey the key of the array, see arrayKey()
+        * @param attr index of the attribute
+        * @param x_min lower x index of the window
+        * @param y_min lower y index of the window
+        * @param x_max upper x index of the window
+        * @param y_max upper y index of the window
+        */
+        static string key(const string& arraykey, int attr,
+                          int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max);
+
+        /**
+        * @brief Copies a buffered slice of a window and marks it as accessed
+        * @param key the key of the window
+        * @param t the temporal index
+        * @param out output buffer of size bytes
+        * @param size the size of one slice of the window in bytes
+        * @return true if the slice was buffered
+        */
+        static bool get(const string& key, int64_t t, void* out, size_t size);
+
+        /**
+        * @brief Marks a slice of a window as accessed
+        * @param key the key of the window
+        * @param t the temporal index
+        * @return true if the previous access of the window was at t - 1
+        */
+        static bool sequential(const string& key, int64_t t);
+
+        /**
+        * @brief Buffers consecutive slices of a window, replacing previously buffered slices
+        * @param key the key of the window
+        * @param t0 the temporal index of the first slice
+        * @param data the slices, one after another
+        * @param size the size of one slice in bytes
+        * @param n the number of slices
+        */
+        static void put(const string& key, int64_t t0, const void* data, size_t size, size_t n);
+
+        /**
+        * @brief Drops all buffered slices of all versions of an array, e.g. after the array has been modified
+        * @param con the connection parameters of the modifying operation
+        * @param arrayname the name of the array
+        */
+        static void remove(const ConnectionParameters& con, const string& arrayname);
+    };
+}
+
+#endif
@@ -30,6 +30,8 @@ namespace scidb4gdal {
     * A structure for storing metadata of an attribute of a SciDB array
     */
     struct SciDBAttribute {
+        SciDBAttribute() : nullable(false), type(Utils::scidbTypeDesc(SCIDB_TYPE_UNKNOWN)) {}
+
         /** the name of the attribute as stored in SciDB */
         string name;
         /** the name of the data type that the values will represent */
@@ -38,6 +40,32 @@ namespace scidb4gdal {
         bool nullable;
         /** metadata about the domain of the attribute */
         DomainMD md;
+        /** descriptor of the data type, resolved from typeId by setType() */
+        SciDBTypeDesc type;
+
+        /**
+        * @brief Sets the data type of the attribute and resolves its type descriptor
+        * @param id SciDB type identifier string e.g. "int32"
+        */
+        void setType(const string& id) {
+            typeId = id;
+            type = Utils::scidbTypeDesc(id);
+        }
+
+        /**
+        * @brief Returns the no data value of the attribute
+        *
+        * The value is taken from the attribute metadata if available and defaults to the no data value of the data type otherwise.
+        * @return string representation of the no data value, as used in AFL queries
+        */
+        string noData() {
+            MD& m = md[""];
+            MD::const_iterator it = m.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA);
+            if (it != m.end()) return it->second;
+            stringstream dtos;
+            dtos << type.defaultNoData;
+            return dtos.str();
+        }
     };
 
     /**
@@ -47,6 +75,24 @@ namespace scidb4gdal {
         double min, max, mean, stdev;
     };
 
+    /**
+    * A structure to store a histogram of a band with equally sized buckets
+    */
+    struct SciDBHistogram {
+        /** lower bound of the first bucket */
+        double min;
+        /** upper bound of the last bucket */
+        double max;
+        /** whether values outside [min, max) are counted by the first or last bucket */
+        bool includeOutOfRange;
+        /** whether the counts have been computed from a sample of the cells */
+        bool approx;
+        /** number of values per bucket, empty if the histogram is unknown */
+        vector<uint64_t> counts;
+
+        SciDBHistogram() : min(0), max(0), includeOutOfRange(false), approx(false) {}
+    };
+
     /**
     * A structure for storing metadata of a dimension of a SciDB Array
     */
@@ -459,6 +505,13 @@ namespace scidb4gdal {
         */
         virtual ~SciDBSpatialArray() {}
 
+        /**
+        * @brief Creates a deep copy of the array descriptor, preserving its dynamic type
+        *
+        * @return a newly allocated copy owned by the caller
+        */
+        virtual SciDBSpatialArray* clone() { return new SciDBSpatialArray(*this); }
+
         /** The position index of the designated x dimension (West-East) in the dimension list */
         int _x_idx;
         /** the position of the designated y dimension (North-South) in the dimension list*/
@@ -611,6 +664,9 @@ namespace scidb4gdal {
         */
         SciDBSpatioTemporalArray(string t0text, string dttext)
             : SciDBSpatialArray(), SciDBTemporalArray(t0text, dttext) {}
+
+        /** @copydoc SciDBSpatialArray::clone */
+        virtual SciDBSpatialArray* clone() { return new SciDBSpatioTemporalArray(*this); }
     };
 }
 
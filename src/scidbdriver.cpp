@@ -33,6 +33,9 @@ SOFTWARE.
 #include "shim_client_structs.h"
 #include "scidb_structs.h"
 #include "parameter_parser.h"
+#include "arraydesccache.h"
+#include "scidbmultidim.h"
+#include "readahead.h"
 
 CPL_C_START
 void GDALRegister_SciDB(void);
@@ -50,6 +53,9 @@ void GDALRegister_SciDB() {
         poDriver = new GDALDriver();
         poDriver->SetDescription("SciDB");
         poDriver->SetMetadataItem(GDAL_DCAP_RASTER, "YES");
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 1, 0)
+        poDriver->SetMetadataItem(GDAL_DCAP_MULTIDIM_RASTER, "YES");
+#endif
         std::stringstream driverlongname;
         driverlongname << "SciDB array driver(" << "BUILD " << __DATE__ << " " << __TIME__ << ")";
         poDriver->SetMetadataItem(GDAL_DMD_LONGNAME, driverlongname.str().c_str());
@@ -83,12 +89,24 @@ void GDALRegister_SciDB() {
         co_descr << "    <Option name='srs' type='string'  description='spatial reference system (deprecated)'/>";
         co_descr << "    <Option name='t' type='string'  description='datetime as ISO8601 string'/>";
         co_descr << "    <Option name='dt' type='string' description='temporal resolution as ISO8601 period string'/>";
+        co_descr << "    <Option name='BATCH' type='boolean' description='stage images appended to an existing STS array until a temporal chunk is complete'/>";
+        co_descr << "    <Option name='FLUSH' type='boolean' description='insert all staged images into the target array'/>";
+        co_descr << "    <Option name='HISTOGRAM' type='boolean' description='compute default histograms of 8 and 16 bit integer bands while uploading'/>";
+        co_descr << "    <Option name='SOURCES' type='string' description='text file listing further images to append to an STS array, one file name per line, optionally followed by a semicolon and the timestamp'/>";
         co_descr << "</CreationOptionList>";
         poDriver->SetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST, co_descr.str().c_str());
         
         
-        oo_descr << "    <Option name='timestamp' type='string' description='datetime as ISO8601 string to query a temporal slice of a spacetime array'/>";
-        oo_descr << "    <Option name='t' type='int' description='temporal array index to query a temporal slice of a spacetime array'/>";
+        oo_descr << "    <Option name='timestamp' type='string' description='datetime as ISO8601 string to query a temporal slice of a spacetime array, or start/end to query a range of slices as bands'/>";
+        oo_descr << "    <Option name='t' type='string' description='temporal array index to query a temporal slice of a spacetime array, or low:high to query a range of slices as bands'/>";
+        oo_descr << "    <Option name='reduce' type='string' description='comma separated temporal reductions (mean, min, max, count) over the temporal range, computed in SciDB and returned as bands'/>";
+        oo_descr << "    <Option name='stats_sample' type='float' default='0.01' description='fraction of cells sampled for approximate statistics'/>";
+        oo_descr << "    <Option name='dense_threshold' type='float' default='1' description='minimum fraction of non-empty cells of the previous block to fetch a block without cell positions'/>";
+        oo_descr << "    <Option name='read_strategy' type='string-select' default='auto' description='operator that cuts blocks out of the array'>";
+        oo_descr << "      <Value>auto</Value>";
+        oo_descr << "      <Value>subarray</Value>";
+        oo_descr << "      <Value>between</Value>";
+        oo_descr << "    </Option>";
         oo_descr <<  "</OpenOptionList>";
         poDriver->SetMetadataItem(GDAL_DMD_OPENOPTIONLIST, oo_descr.str().c_str());
         
@@ -109,13 +127,14 @@ namespace scidb4gdal {
     *  SciDBRasterBand
     * =============================================
     */
-    SciDBRasterBand::SciDBRasterBand(SciDBDataset* poDS, SciDBSpatialArray* array,int nBand) 
+    SciDBRasterBand::SciDBRasterBand(SciDBDataset* poDS, SciDBSpatialArray* array, int nBand, int tIndex, int reduction)
+        : _array(array), _attr(nBand), _t(tIndex), _reduction(reduction)
     {
         this->poDS = poDS;
         this->nBand = nBand;
-        this->_array = array;
 
-        eDataType = Utils::scidbTypeIdToGDALType( _array->attrs[nBand].typeId); // Data type is mapped from SciDB's attribute data type
+        eDataType = _array->attrs[nBand].type.gdalType; // Data type is mapped from SciDB's attribute data type
+        if (_reduction >= 0) eDataType = GDT_Float64; // Reductions are always computed as double
 
         uint32_t nImgYSize(1 + _array->getYDim()->high - _array->getYDim()->low);
         uint32_t nImgXSize(1 + _array->getXDim()->high - _array->getXDim()->low);
@@ -132,19 +151,166 @@ namespace scidb4gdal {
     CPLErr SciDBRasterBand::GetStatistics(int bApproxOK, int bForce, double* pdfMin,
                                         double* pdfMax, double* pdfMean,
                                         double* pdfStdDev) {
-        SciDBAttributeStats stats;
-        ((SciDBDataset*)poDS)
-            ->getClient()
-            ->getAttributeStats(*_array, this->nBand - 1, stats);
+        if (_reduction >= 0) // Statistics of the attribute do not apply to reductions
+            return GDALPamRasterBand::GetStatistics(bApproxOK, bForce, pdfMin, pdfMax, pdfMean, pdfStdDev);
 
-        *pdfMin = stats.min;
-        *pdfMax = stats.max;
-        *pdfMean = stats.mean;
-        *pdfStdDev = stats.stdev;
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        const int64_t t = sliceIndex();
+        bool approx;
+        if (t >= 0) {
+            // statistics of the temporal slice only
+            map<int64_t, SciDBDataset::SliceStats>::iterator it = poGDS->_sliceStats.find(t);
+            if (it == poGDS->_sliceStats.end() || (it->second.approx && !bApproxOK)) {
+                if (!bForce) return CE_Warning;
+                if (poGDS->computeSliceStatistics(t, bApproxOK) != SUCCESS) return CE_Failure;
+                it = poGDS->_sliceStats.find(t);
+            }
+            approx = it->second.approx;
+        } else {
+            if (poGDS->_stats.empty()) poGDS->loadStatistics();
+            if (poGDS->_stats.empty() || (poGDS->_statsApprox && !bApproxOK)) {
+                if (!bForce) return CE_Warning;
+                if (poGDS->computeStatistics(bApproxOK) != SUCCESS) return CE_Failure;
+            }
+            approx = poGDS->_statsApprox;
+        }
+        const SciDBAttributeStats& stats = (t >= 0) ? poGDS->_sliceStats[t].stats[_attr] : poGDS->_stats[_attr];
+        if (CPLIsNan(stats.mean)) {
+            Utils::warn("Band has no valid values, cannot compute statistics");
+            return CE_Failure;
+        }
+
+        if (pdfMin) *pdfMin = stats.min;
+        if (pdfMax) *pdfMax = stats.max;
+        if (pdfMean) *pdfMean = stats.mean;
+        if (pdfStdDev) *pdfStdDev = stats.stdev;
+        SetStatistics(stats.min, stats.max, stats.mean, stats.stdev);
+        SetMetadataItem(SCIDB4GDAL_DEFAULTMDFIELD_STATS_APPROX, approx ? "YES" : NULL);
+
+        return CE_None;
+    }
+
+    CPLErr SciDBRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram, int bIncludeOutOfRange,
+                                         int bApproxOK, GDALProgressFunc pfnProgress, void* pProgressData) {
+        if (_reduction >= 0 || nBuckets <= 0 || !(dfMax > dfMin))
+            return GDALPamRasterBand::GetHistogram(dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange, bApproxOK,
+                                                   pfnProgress, pProgressData);
+        if (pfnProgress == NULL) pfnProgress = GDALDummyProgress;
+
+        bool cached = _hist.counts.size() == (size_t) nBuckets && _hist.min == dfMin && _hist.max == dfMax &&
+                      _hist.includeOutOfRange == (bIncludeOutOfRange != 0) && (bApproxOK || !_hist.approx);
+        if (!cached && bIncludeOutOfRange && sliceIndex() < 0) {
+            // the default histogram counts out of range values
+            SciDBHistogram def;
+            if (loadDefaultHistogram(def) && def.counts.size() == (size_t) nBuckets && def.min == dfMin && def.max == dfMax) {
+                _hist = def;
+                cached = true;
+            }
+        }
+        if (!cached) {
+            SciDBDataset* poGDS = (SciDBDataset*)poDS;
+            SciDBHistogram hist;
+            hist.min = dfMin;
+            hist.max = dfMax;
+            hist.includeOutOfRange = bIncludeOutOfRange != 0;
+            hist.counts.resize(nBuckets);
+            if (poGDS->_client->getAttributeHistogram(*_array, _attr, hist, bApproxOK ? poGDS->statsSample() : 1, sliceIndex()) != SUCCESS) {
+                // compute the histogram from the pixels if SciDB cannot
+                return GDALPamRasterBand::GetHistogram(dfMin, dfMax, nBuckets, panHistogram, bIncludeOutOfRange, bApproxOK,
+                                                       pfnProgress, pProgressData);
+            }
+            _hist = hist;
+        }
 
+        for (int i = 0; i < nBuckets; ++i) panHistogram[i] = (GUIntBig) _hist.counts[i];
+        if (!pfnProgress(1.0, NULL, pProgressData)) {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
         return CE_None;
     }
 
+    CPLErr SciDBRasterBand::GetDefaultHistogram(double* pdfMin, double* pdfMax, int* pnBuckets, GUIntBig** ppanHistogram, int bForce,
+                                                GDALProgressFunc pfnProgress, void* pProgressData) {
+        if (_reduction >= 0)
+            return GDALPamRasterBand::GetDefaultHistogram(pdfMin, pdfMax, pnBuckets, ppanHistogram, bForce, pfnProgress, pProgressData);
+
+        // default histograms of temporal slices are not stored, the last histogram of the band is cached anyway
+        SciDBHistogram def;
+        if (sliceIndex() >= 0 || !loadDefaultHistogram(def)) {
+            if (!bForce) return CE_Warning;
+
+            // buckets as chosen by GDALRasterBand::GetDefaultHistogram()
+            def.counts.resize(256);
+            if (eDataType == GDT_Byte) {
+                def.min = -0.5;
+                def.max = 255.5;
+            } else {
+                double dfMean, dfStdDev;
+                if (GetStatistics(TRUE, TRUE, &def.min, &def.max, &dfMean, &dfStdDev) != CE_None)
+                    return CE_Failure;
+                double dfHalfBucket = (def.max - def.min) / (2 * (def.counts.size() - 1));
+                def.min -= dfHalfBucket;
+                def.max += dfHalfBucket;
+                if (!(def.max > def.min)) def.max = def.min + 1; // constant band
+            }
+            vector<GUIntBig> counts(def.counts.size());
+            if (GetHistogram(def.min, def.max, (int) counts.size(), &counts[0], TRUE, FALSE, pfnProgress, pProgressData) != CE_None)
+                return CE_Failure;
+            if (sliceIndex() < 0) SetDefaultHistogram(def.min, def.max, (int) counts.size(), &counts[0]);
+            def = _hist;
+        }
+
+        *pdfMin = def.min;
+        *pdfMax = def.max;
+        *pnBuckets = (int) def.counts.size();
+        *ppanHistogram = (GUIntBig*) CPLMalloc(sizeof (GUIntBig) * def.counts.size());
+        for (size_t i = 0; i < def.counts.size(); ++i) (*ppanHistogram)[i] = (GUIntBig) def.counts[i];
+        return CE_None;
+    }
+
+    CPLErr SciDBRasterBand::SetDefaultHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram) {
+        if (_reduction >= 0 || sliceIndex() >= 0)
+            return GDALPamRasterBand::SetDefaultHistogram(dfMin, dfMax, nBuckets, panHistogram);
+
+        stringstream counts;
+        for (int i = 0; i < nBuckets; ++i) counts << (i > 0 ? " " : "") << panHistogram[i];
+        MD kv;
+        kv[SCIDB4GDAL_DEFAULTMDFIELD_HIST_MIN] = CPLSPrintf("%.17g", dfMin);
+        kv[SCIDB4GDAL_DEFAULTMDFIELD_HIST_MAX] = CPLSPrintf("%.17g", dfMax);
+        kv[SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS] = counts.str();
+        MD& md = _array->attrs[_attr].md[""];
+        for (MD::iterator it = kv.begin(); it != kv.end(); ++it) md[it->first] = it->second;
+
+        ShimClient* client = ((SciDBDataset*)poDS)->getClient();
+        if (client->hasSCIDB4GEO())
+            client->setAttributeMD(_array->name, _array->attrs[_attr].name, kv);
+        return CE_None;
+    }
+
+    bool SciDBRasterBand::loadDefaultHistogram(SciDBHistogram& out) {
+        MD& md = _array->attrs[_attr].md[""];
+        MD::iterator itmin = md.find(SCIDB4GDAL_DEFAULTMDFIELD_HIST_MIN);
+        MD::iterator itmax = md.find(SCIDB4GDAL_DEFAULTMDFIELD_HIST_MAX);
+        MD::iterator itcounts = md.find(SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS);
+        if (itmin == md.end() || itmax == md.end() || itcounts == md.end()) return false;
+
+        vector<string> counts;
+        string s = boost::algorithm::trim_copy(itcounts->second);
+        boost::split(counts, s, boost::is_any_of(" "), boost::token_compress_on);
+        try {
+            out.min = boost::lexical_cast<double>(boost::algorithm::trim_copy(itmin->second));
+            out.max = boost::lexical_cast<double>(boost::algorithm::trim_copy(itmax->second));
+            out.counts.resize(counts.size());
+            for (size_t i = 0; i < counts.size(); ++i) out.counts[i] = boost::lexical_cast<uint64_t>(counts[i]);
+        } catch (boost::bad_lexical_cast&) {
+            return false; // also outdated histograms, see SciDBDataset::clearStatistics()
+        }
+        out.includeOutOfRange = true;
+        out.approx = false;
+        return !out.counts.empty();
+    }
+
     CPLErr SciDBRasterBand::IReadBlock(int nBlockXOff, int nBlockYOff,
                                     void* pImage) {
         // TODO: Improve error handling
@@ -154,9 +320,7 @@ namespace scidb4gdal {
         // 	int32_t t_index = poGDS->_client->
         //
         // 	->_query->temp_index;
-        uint32_t tileId =
-            TileCache::getBlockId(nBlockXOff, nBlockYOff, nBand - 1, nBlockXSize,
-                                nBlockYSize, poGDS->GetRasterCount());
+        uint32_t tileId = getTileId(nBlockXOff, nBlockYOff, nBand);
 
         ArrayTile tile;
         tile.id = tileId;
@@ -164,67 +328,19 @@ namespace scidb4gdal {
         // Check whether chunk is in cache
         if (poGDS->_cache.has(tileId)) {
             tile = *poGDS->_cache.get(tileId);
+        } else if (_t >= 0) {
+            // bands of a temporal range are read all at once
+            return readTemporalRangeBlock(nBlockXOff, nBlockYOff, pImage);
+        } else if (_reduction >= 0) {
+            return readTemporalReductionBlock(nBlockXOff, nBlockYOff, pImage);
+        } else if (!poGDS->_arraykey.empty() && readSliceAhead(nBlockXOff, nBlockYOff, pImage)) {
+            // temporal slice has been read ahead while reading a previous slice
+            return CE_None;
         } else {
-            int xmin = nBlockXOff * this->nBlockXSize + _array->getXDim()->low;
-            int xmax = xmin + this->nBlockXSize - 1;
-            if (xmax > _array->getXDim()->high)
-                xmax = _array->getXDim()->high;
-
-            int ymin = nBlockYOff * this->nBlockYSize + _array->getYDim()->low;
-            int ymax = ymin + this->nBlockYSize - 1;
-            if (ymax > _array->getYDim()->high)
-                ymax = _array->getYDim()->high;
-
-            // Read  and fetch data
-            bool use_subarray = true; // This is safer, between might lead to
-            // inconsistent results in some instances
-            // bool use_subarray = ! ( ( xmin % ( int ) _array->getXDim()->chunksize ==
-            // 0 ) && ( ymin % ( int ) _array->getYDim()->chunksize == 0 ) );
-
-            tile.size =
-                nBlockXSize * nBlockYSize *
-                Utils::scidbTypeIdBytes(
-                    _array->attrs[nBand - 1].typeId); // Always allocate full block size
-            tile.data = malloc(tile.size);            // will be freed automatically by cache
-
-            if ((nBlockXOff + 1) * this->nBlockXSize > poGDS->nRasterXSize) {
-                // This is a bit of a hack...
-//                 size_t dataSize = _array->attrs[nBand - 1].nullable ?  
-//                     (1 + xmax - xmin) * (1 + ymax - ymin) *   (Utils::scidbTypeIdBytes( _array->attrs[nBand - 1] .typeId + 1)) :
-//                     (1 + xmax - xmin) * (1 + ymax - ymin) *   Utils::scidbTypeIdBytes( _array->attrs[nBand - 1] .typeId); // This is smaller than the block size!
-                size_t dataSize = (1 + xmax - xmin) * (1 + ymax - ymin) *   Utils::scidbTypeIdBytes( _array->attrs[nBand - 1] .typeId); // This is smaller than the block size!
-   
-                void* buf = malloc(dataSize);
-
-                // Write to temporary buffer first
-                // TODO  t_index is set as zero for compiler testing... this must be
-                // changed
-                poGDS->getClient()->getData(*_array, nBand - 1, buf, xmin, ymin, xmax,
-                                            ymax, use_subarray); // GDAL bands start with
-                // 1, scidb attribute
-                // indexes with 0
-                for (int i = 0; i < (1 + ymax - ymin); ++i) {
-                    uint8_t* src = &((uint8_t*)buf)[i * (1 + xmax - xmin) *
-                                                    Utils::scidbTypeIdBytes(
-                                                        _array->attrs[nBand - 1].typeId)];
-                    uint8_t* dest =
-                        &((uint8_t*)tile.data)[i * this->nBlockXSize *
-                                            Utils::scidbTypeIdBytes(
-                                                _array->attrs[nBand - 1].typeId)];
-                    memcpy(dest, src,
-                        (1 + xmax - xmin) *
-                            Utils::scidbTypeIdBytes(_array->attrs[nBand - 1].typeId));
-                }
-                free(buf);
-            } else {
-                // This is the most efficient!
-                poGDS->getClient()->getData(*_array, nBand - 1, tile.data, xmin, ymin,
-                                            xmax, ymax,
-                                            use_subarray); // GDAL bands start
-                                                        // with 1, scidb
-                                                        // attribute
-                                                        // indexes with 0
-            }
+            ArrayTile mask;
+            if (fetchBlock(nBlockXOff, nBlockYOff, tile, mask) != CE_None)
+                return CE_Failure;
+            poGDS->cacheTile(mask);
         }
 
         poGDS->_cache.add(tile); // Add to cache
@@ -236,10 +352,408 @@ namespace scidb4gdal {
         return CE_None;
     }
 
+    CPLErr SciDBRasterBand::fetchBlock(int nBlockXOff, int nBlockYOff, ArrayTile& tile, ArrayTile& mask) {
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+
+        int xmin = nBlockXOff * this->nBlockXSize + _array->getXDim()->low;
+        int xmax = xmin + this->nBlockXSize - 1;
+        if (xmax > _array->getXDim()->high)
+            xmax = _array->getXDim()->high;
+
+        int ymin = nBlockYOff * this->nBlockYSize + _array->getYDim()->low;
+        int ymax = ymin + this->nBlockYSize - 1;
+        if (ymax > _array->getYDim()->high)
+            ymax = _array->getYDim()->high;
+
+        // Read  and fetch data, the client chooses between subarray() and between() per block
+        const size_t typeBytes = _array->attrs[_attr].type.bytes;
+        tile.id = getTileId(nBlockXOff, nBlockYOff, nBand);
+        tile.size =
+            nBlockXSize * nBlockYSize * typeBytes; // Always allocate full block size
+        tile.data = malloc(tile.size);            // will be freed automatically by cache
+        mask.id = SciDBMaskBand::getTileId(poDS, nBlockXOff, nBlockYOff, nBlockXSize, nBlockYSize);
+        mask.size = nBlockXSize * nBlockYSize;
+        mask.data = calloc(mask.size, 1);
+
+        StatusCode res;
+        if ((nBlockXOff + 1) * this->nBlockXSize > poGDS->nRasterXSize) {
+            // This is a bit of a hack...
+            size_t n = (1 + xmax - xmin) * (1 + ymax - ymin);
+            size_t dataSize = n * typeBytes; // This is smaller than the block size!
+
+            void* buf = malloc(dataSize);
+            uint8_t* maskbuf = (uint8_t*) malloc(n);
+
+            // Write to temporary buffer first
+            res = poGDS->getClient()->getData(*_array, _attr, buf, xmin, ymin, xmax,
+                                              ymax, READ_AUTO, true, maskbuf); // GDAL bands start with
+            // 1, scidb attribute
+            // indexes with 0
+            const size_t srcRowBytes = (1 + xmax - xmin) * typeBytes;
+            const size_t destRowBytes = this->nBlockXSize * typeBytes;
+            for (int i = 0; i < (1 + ymax - ymin); ++i) {
+                memcpy(&((uint8_t*)tile.data)[i * destRowBytes], &((uint8_t*)buf)[i * srcRowBytes], srcRowBytes);
+                memcpy(&((uint8_t*)mask.data)[i * this->nBlockXSize], &maskbuf[i * (1 + xmax - xmin)], 1 + xmax - xmin);
+            }
+            free(buf);
+            free(maskbuf);
+        } else {
+            // This is the most efficient!
+            res = poGDS->getClient()->getData(*_array, _attr, tile.data, xmin, ymin,
+                                              xmax, ymax,
+                                              READ_AUTO, true, (uint8_t*) mask.data); // GDAL bands start
+                                                                                         // with 1, scidb
+                                                                                         // attribute
+                                                                                         // indexes with 0
+        }
+        if (res != SUCCESS) {
+            free(tile.data);
+            free(mask.data);
+            tile.data = mask.data = NULL;
+            return CE_Failure;
+        }
+        return CE_None;
+    }
+
+    int SciDBRasterBand::GetMaskFlags() {
+        if (!hasDatasetMask())
+            return GDALPamRasterBand::GetMaskFlags();
+        return GMF_PER_DATASET;
+    }
+
+    GDALRasterBand* SciDBRasterBand::GetMaskBand() {
+        if (!hasDatasetMask())
+            return GDALPamRasterBand::GetMaskBand();
+        return ((SciDBDataset*)poDS)->_maskBand;
+    }
+
+    int64_t SciDBRasterBand::sliceIndex() {
+        return (_t >= 0) ? _t : ((SciDBDataset*)poDS)->_tindex;
+    }
+
+    bool SciDBRasterBand::hasDatasetMask() {
+        if (!((SciDBDataset*)poDS)->_maskBand || _t >= 0 || _reduction >= 0)
+            return false;
+        // the mask of empty cells would mark null values as valid
+        int hasNoData = FALSE;
+        GetNoDataValue(&hasNoData);
+        return !hasNoData;
+    }
+
+    uint32_t SciDBRasterBand::getTileId(int nBlockXOff, int nBlockYOff, int band) {
+        int nx = (poDS->GetRasterXSize() + nBlockXSize - 1) / nBlockXSize;
+        int ny = (poDS->GetRasterYSize() + nBlockYSize - 1) / nBlockYSize;
+        return TileCache::getBlockId(nBlockXOff, nBlockYOff, band - 1, nx, ny, poDS->GetRasterCount());
+    }
+
+    CPLErr SciDBRasterBand::readTemporalRangeBlock(int nBlockXOff, int nBlockYOff, void* pImage) {
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(_array);
+        if (!starray) return CE_Failure;
+
+        int64_t xmin = nBlockXOff * (int64_t) nBlockXSize + _array->getXDim()->low;
+        int64_t xmax = std::min(xmin + nBlockXSize - 1, _array->getXDim()->high);
+        int64_t ymin = nBlockYOff * (int64_t) nBlockYSize + _array->getYDim()->low;
+        int64_t ymax = std::min(ymin + nBlockYSize - 1, _array->getYDim()->high);
+        int64_t tmin = poGDS->_tlow;
+        int64_t tmax = poGDS->_thigh;
+        const size_t nx = (size_t) (xmax - xmin + 1);
+        const size_t ny = (size_t) (ymax - ymin + 1);
+        const size_t nt = (size_t) (tmax - tmin + 1);
+        const size_t nattrs = _array->attrs.size();
+
+        // One 3-D query for all attributes and time steps of this block
+        vector<uint8_t> bands(nattrs);
+        vector<void*> bufs(nattrs, (void*) NULL);
+        bool ok = true;
+        for (size_t a = 0; a < nattrs; ++a) {
+            bands[a] = (uint8_t) a;
+            bufs[a] = malloc(nx * ny * nt * _array->attrs[a].type.bytes);
+            if (bufs[a] == NULL) ok = false;
+        }
+        if (!ok || poGDS->_client->getHyperslab(*_array, bands, bufs, xmin, ymin, xmax, ymax, tmin, tmax) != SUCCESS) {
+            for (size_t a = 0; a < nattrs; ++a) free(bufs[a]);
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot read block of temporal range from array '%s'", _array->name.c_str());
+            return CE_Failure;
+        }
+
+        // Demultiplex into one tile per band, the requested one is written to pImage directly
+        for (size_t t = 0; t < nt; ++t) {
+            for (size_t a = 0; a < nattrs; ++a) {
+                int band = (int) (t * nattrs + a) + 1;
+                const size_t typeBytes = _array->attrs[a].type.bytes;
+                uint8_t* src = (uint8_t*) bufs[a] + t * nx * ny * typeBytes;
+
+                ArrayTile tile;
+                tile.id = getTileId(nBlockXOff, nBlockYOff, band);
+                tile.size = nBlockXSize * nBlockYSize * typeBytes;
+                if (band != nBand && poGDS->_cache.has(tile.id)) continue;
+                tile.data = (band == nBand) ? pImage : malloc(tile.size);
+                if (tile.data == NULL) continue;
+
+                const size_t srcRowBytes = nx * typeBytes;
+                const size_t destRowBytes = nBlockXSize * typeBytes;
+                for (size_t i = 0; i < ny; ++i) {
+                    memcpy(&((uint8_t*)tile.data)[i * destRowBytes], &src[i * srcRowBytes], srcRowBytes);
+                }
+                if (band != nBand) {
+                    poGDS->_cache.add(tile);
+                    if (!poGDS->_cache.has(tile.id)) free(tile.data);
+                }
+            }
+        }
+        for (size_t a = 0; a < nattrs; ++a) free(bufs[a]);
+        return CE_None;
+    }
+
+    CPLErr SciDBRasterBand::readTemporalReductionBlock(int nBlockXOff, int nBlockYOff, void* pImage) {
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(_array);
+        if (!starray) return CE_Failure;
+
+        int64_t xmin = nBlockXOff * (int64_t) nBlockXSize + _array->getXDim()->low;
+        int64_t xmax = std::min(xmin + nBlockXSize - 1, _array->getXDim()->high);
+        int64_t ymin = nBlockYOff * (int64_t) nBlockYSize + _array->getYDim()->low;
+        int64_t ymax = std::min(ymin + nBlockYSize - 1, _array->getYDim()->high);
+        const size_t nx = (size_t) (xmax - xmin + 1);
+        const size_t ny = (size_t) (ymax - ymin + 1);
+        const size_t nops = poGDS->_reductions.size();
+
+        // One aggregation query for all reductions of this attribute
+        vector<double*> bufs(nops, (double*) NULL);
+        bool ok = true;
+        for (size_t r = 0; r < nops; ++r) {
+            bufs[r] = (double*) malloc(nx * ny * sizeof (double));
+            if (bufs[r] == NULL) ok = false;
+        }
+        if (!ok || poGDS->_client->getTemporalReduction(*starray, _attr, poGDS->_reductions, bufs, xmin, ymin, xmax, ymax,
+                                                        poGDS->_tlow, poGDS->_thigh) != SUCCESS) {
+            for (size_t r = 0; r < nops; ++r) free(bufs[r]);
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot compute temporal reduction of array '%s'", _array->name.c_str());
+            return CE_Failure;
+        }
+
+        for (size_t r = 0; r < nops; ++r) {
+            int band = (int) (_attr * nops + r) + 1;
+            ArrayTile tile;
+            tile.id = getTileId(nBlockXOff, nBlockYOff, band);
+            tile.size = nBlockXSize * nBlockYSize * sizeof (double);
+            if (band != nBand && poGDS->_cache.has(tile.id)) continue;
+            tile.data = (band == nBand) ? pImage : malloc(tile.size);
+            if (tile.data == NULL) continue;
+
+            const size_t srcRowBytes = nx * sizeof (double);
+            const size_t destRowBytes = nBlockXSize * sizeof (double);
+            for (size_t i = 0; i < ny; ++i) {
+                memcpy(&((uint8_t*)tile.data)[i * destRowBytes], (uint8_t*) bufs[r] + i * srcRowBytes, srcRowBytes);
+            }
+            if (band != nBand) {
+                poGDS->_cache.add(tile);
+                if (!poGDS->_cache.has(tile.id)) free(tile.data);
+            }
+        }
+        for (size_t r = 0; r < nops; ++r) free(bufs[r]);
+        return CE_None;
+    }
+
+    bool SciDBRasterBand::readSliceAhead(int nBlockXOff, int nBlockYOff, void* pImage) {
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(_array);
+        if (!starray || poGDS->_tindex < 0) return false;
+
+        int64_t xmin = nBlockXOff * (int64_t) nBlockXSize + _array->getXDim()->low;
+        int64_t xmax = std::min(xmin + nBlockXSize - 1, _array->getXDim()->high);
+        int64_t ymin = nBlockYOff * (int64_t) nBlockYSize + _array->getYDim()->low;
+        int64_t ymax = std::min(ymin + nBlockYSize - 1, _array->getYDim()->high);
+        const size_t nx = (size_t) (xmax - xmin + 1);
+        const size_t ny = (size_t) (ymax - ymin + 1);
+        const size_t typeBytes = _array->attrs[_attr].type.bytes;
+        const size_t sliceBytes = nx * ny * typeBytes;
+        const int64_t t = poGDS->_tindex;
+
+        string key = ReadAhead::key(poGDS->_arraykey, _attr, xmin, ymin, xmax, ymax);
+        // empty cells are shared by all attributes, masks are buffered as attribute -1
+        string maskkey = ReadAhead::key(poGDS->_arraykey, -1, xmin, ymin, xmax, ymax);
+        const size_t maskBytes = nx * ny;
+        const bool masked = hasDatasetMask();
+        const uint32_t maskId = SciDBMaskBand::getTileId(poDS, nBlockXOff, nBlockYOff, nBlockXSize, nBlockYSize);
+        uint8_t* maskbuf = (masked && !poGDS->_cache.has(maskId)) ? (uint8_t*) malloc(maskBytes) : NULL;
+        void* buf = malloc(sliceBytes);
+        if (buf == NULL) {
+            free(maskbuf);
+            return false;
+        }
+        if (ReadAhead::get(key, t, buf, sliceBytes)) {
+            // without a buffered mask, the mask band fetches the block itself
+            if (maskbuf && !ReadAhead::get(maskkey, t, maskbuf, maskBytes)) {
+                free(maskbuf);
+                maskbuf = NULL;
+            }
+        } else {
+            if (!ReadAhead::sequential(key, t)) {
+                free(maskbuf);
+                free(buf);
+                return false;
+            }
+
+            // Fetch up to the end of the temporal chunk, but at least a few slices
+            SciDBDimension* tdim = starray->getTDim();
+            int64_t cs = (tdim->chunksize > 0) ? tdim->chunksize : 1;
+            int64_t tmax = tdim->start + ((t - tdim->start) / cs + 1) * cs - 1; // chunks are aligned to the declared start
+            tmax = std::max(tmax, t + SCIDB4GDAL_READAHEAD_MINSLICES - 1);
+            tmax = std::min(tmax, tdim->high);
+            if (tmax <= t) {
+                free(maskbuf);
+                free(buf);
+                return false;
+            }
+            const size_t n = (size_t) (tmax - t + 1);
+            void* slab = malloc(n * sliceBytes);
+            uint8_t* maskslab = masked ? (uint8_t*) malloc(n * maskBytes) : NULL;
+            if (slab == NULL || (masked && maskslab == NULL) ||
+                poGDS->_client->getHyperslab(*_array, _attr, slab, xmin, ymin, xmax, ymax, t, tmax, maskslab) != SUCCESS) {
+                free(maskslab);
+                free(slab);
+                free(maskbuf);
+                free(buf);
+                return false;
+            }
+            Utils::debug("Read ahead " + boost::lexical_cast<string>(n - 1) + " temporal slices of array '" + _array->name + "'");
+            memcpy(buf, slab, sliceBytes);
+            ReadAhead::put(key, t + 1, (uint8_t*) slab + sliceBytes, sliceBytes, n - 1);
+            if (maskslab) {
+                if (maskbuf) memcpy(maskbuf, maskslab, maskBytes);
+                ReadAhead::put(maskkey, t + 1, maskslab + maskBytes, maskBytes, n - 1);
+            }
+            free(maskslab);
+            free(slab);
+        }
+
+        const size_t srcRowBytes = nx * typeBytes;
+        const size_t destRowBytes = nBlockXSize * typeBytes;
+        for (size_t i = 0; i < ny; ++i) {
+            memcpy((uint8_t*) pImage + i * destRowBytes, (uint8_t*) buf + i * srcRowBytes, srcRowBytes);
+        }
+        free(buf);
+
+        // cache the mask tile as fetchBlock() does, such that the mask band does not fetch the block again
+        if (maskbuf) {
+            ArrayTile mask;
+            mask.id = maskId;
+            mask.size = nBlockXSize * nBlockYSize;
+            mask.data = calloc(mask.size, 1);
+            if (mask.data) {
+                for (size_t i = 0; i < ny; ++i) {
+                    memcpy((uint8_t*) mask.data + i * nBlockXSize, maskbuf + i * nx, nx);
+                }
+                poGDS->cacheTile(mask);
+            }
+            free(maskbuf);
+        }
+        return true;
+    }
+
+    const char* SciDBRasterBand::GetMetadataItem(const char* pszName, const char* pszDomain) {
+        if (pszName == NULL || pszDomain == NULL || !EQUAL(pszDomain, "TIMESERIES"))
+            return GDALPamRasterBand::GetMetadataItem(pszName, pszDomain);
+
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(_array);
+        int64_t tmin = 0, tmax = 0;
+        if (poGDS->_tlow >= 0) {
+            tmin = poGDS->_tlow;
+            tmax = poGDS->_thigh;
+        } else if (starray) {
+            tmin = starray->getTDim()->low;
+            tmax = starray->getTDim()->high;
+        }
+
+        if (EQUAL(pszName, "TIMESTAMPS")) {
+            if (!starray) return NULL;
+            stringstream ts;
+            vector<TPoint> times;
+            starray->datetimesAtIndexRange((int)tmin, (int)tmax, times);
+            for (size_t i = 0; i < times.size(); ++i) {
+                if (i > 0) ts << ",";
+                times[i]._resolution = starray->getTInterval()->_resolution;
+                ts << times[i].toStringISO();
+            }
+            _timeseries = ts.str();
+            return _timeseries.c_str();
+        }
+
+        // Convert locations to array indexes
+        vector<int64_t> xs, ys;
+        vector<string> tokens;
+        string names = pszName;
+        boost::algorithm::trim(names);
+        boost::algorithm::split(tokens, names, boost::algorithm::is_space(), boost::algorithm::token_compress_on);
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            double x, y;
+            if (STARTS_WITH_CI(tokens[i].c_str(), "Pixel_") &&
+                sscanf(tokens[i].c_str() + 6, "%lf_%lf", &x, &y) == 2) {
+                x += _array->getXDim()->low;
+                y += _array->getYDim()->low;
+            } else if (STARTS_WITH_CI(tokens[i].c_str(), "GeoPixel_") &&
+                       sscanf(tokens[i].c_str() + 9, "%lf_%lf", &x, &y) == 2) {
+                AffineTransform::double2 p(x, y);
+                _array->affineTransform.fInv(p);
+                x = p.x;
+                y = p.y;
+            } else {
+                CPLError(CE_Failure, CPLE_IllegalArg, "Invalid location '%s' in time series request", tokens[i].c_str());
+                return NULL;
+            }
+            x = floor(x);
+            y = floor(y);
+            if (x < _array->getXDim()->low || x > _array->getXDim()->high ||
+                y < _array->getYDim()->low || y > _array->getYDim()->high) {
+                CPLError(CE_Failure, CPLE_IllegalArg, "Location '%s' is outside of the array", tokens[i].c_str());
+                return NULL;
+            }
+            xs.push_back((int64_t) x);
+            ys.push_back((int64_t) y);
+        }
+        if (xs.empty()) return NULL;
+
+        const size_t nt = (size_t) (tmax - tmin + 1);
+        const size_t n = xs.size() * nt;
+        void* buf = malloc(n * _array->attrs[_attr].type.bytes);
+        double* values = (double*) malloc(n * sizeof (double));
+        if (buf == NULL || values == NULL ||
+            poGDS->_client->getTimeSeries(*_array, _attr, xs, ys, buf, tmin, tmax) != SUCCESS) {
+            free(buf);
+            free(values);
+            CPLError(CE_Failure, CPLE_AppDefined, "Cannot read time series from array '%s'", _array->name.c_str());
+            return NULL;
+        }
+        GDALCopyWords(buf, eDataType, _array->attrs[_attr].type.bytes, values, GDT_Float64, sizeof (double), (int) n);
+        free(buf);
+
+        stringstream out;
+        out << std::setprecision(15);
+        for (size_t i = 0; i < xs.size(); ++i) {
+            if (i > 0) out << "\n";
+            for (size_t t = 0; t < nt; ++t) {
+                if (t > 0) out << ",";
+                out << values[i * nt + t];
+            }
+        }
+        free(values);
+        _timeseries = out.str();
+        return _timeseries.c_str();
+    }
+
     double SciDBRasterBand::GetNoDataValue(int* pbSuccess) {
+        if (_reduction >= 0) {
+            // Cells without any valid value in the time range
+            if (pbSuccess != NULL)
+                *pbSuccess = true;
+            return std::numeric_limits<double>::quiet_NaN();
+        }
         string key = SCIDB4GDAL_DEFAULTMDFIELD_NODATA;
         double result;
-        MD md = _array->attrs[nBand - 1].md[""];
+        MD md = _array->attrs[_attr].md[""];
         if (md.find(key) == md.end()) {
             if (pbSuccess != NULL)
                 *pbSuccess = false;
@@ -262,8 +776,21 @@ namespace scidb4gdal {
     }
 
     double SciDBRasterBand::GetMaximum(int* pbSuccess) {
+        if (_reduction >= 0) // only statistics computed from the reduced values, if any
+            return GDALPamRasterBand::GetMaximum(pbSuccess);
+
         string key = SCIDB4GDAL_DEFAULTMDFIELD_MAX;
-        MD md = _array->attrs[nBand - 1].md[""]; // TODO: Add domain
+        MD md = _array->attrs[_attr].md[""]; // TODO: Add domain
+        if (md.find(key) == md.end()) {
+            // statistics, e.g. gathered while uploading
+            SciDBDataset* poGDS = (SciDBDataset*)poDS;
+            if (poGDS->_stats.empty() && sliceIndex() < 0) poGDS->loadStatistics();
+            if (!poGDS->_stats.empty()) {
+                if (pbSuccess != NULL)
+                    *pbSuccess = true;
+                return poGDS->_stats[_attr].max;
+            }
+        }
         if (md.find(key) == md.end()) {
             if (pbSuccess != NULL)
                 *pbSuccess = false;
@@ -275,8 +802,21 @@ namespace scidb4gdal {
     }
 
     double SciDBRasterBand::GetMinimum(int* pbSuccess) {
+        if (_reduction >= 0) // only statistics computed from the reduced values, if any
+            return GDALPamRasterBand::GetMinimum(pbSuccess);
+
         string key = SCIDB4GDAL_DEFAULTMDFIELD_MIN;
-        MD md = _array->attrs[nBand - 1].md[""]; // TODO: Add domain
+        MD md = _array->attrs[_attr].md[""]; // TODO: Add domain
+        if (md.find(key) == md.end()) {
+            // statistics, e.g. gathered while uploading
+            SciDBDataset* poGDS = (SciDBDataset*)poDS;
+            if (poGDS->_stats.empty() && sliceIndex() < 0) poGDS->loadStatistics();
+            if (!poGDS->_stats.empty()) {
+                if (pbSuccess != NULL)
+                    *pbSuccess = true;
+                return poGDS->_stats[_attr].min;
+            }
+        }
         if (md.find(key) == md.end()) {
             if (pbSuccess != NULL)
                 *pbSuccess = false;
@@ -288,8 +828,13 @@ namespace scidb4gdal {
     }
 
     double SciDBRasterBand::GetOffset(int* pbSuccess) {
+        if (_reduction >= 0 && ((SciDBDataset*)poDS)->_reductions[_reduction] == "count") {
+            if (pbSuccess != NULL)
+                *pbSuccess = false;
+            return 0;
+        }
         string key = SCIDB4GDAL_DEFAULTMDFIELD_OFFSET;
-        MD md = _array->attrs[nBand - 1].md[""]; // TODO: Add domain
+        MD md = _array->attrs[_attr].md[""]; // TODO: Add domain
         if (md.find(key) == md.end()) {
             if (pbSuccess != NULL)
                 *pbSuccess = false;
@@ -301,8 +846,13 @@ namespace scidb4gdal {
     }
 
     double SciDBRasterBand::GetScale(int* pbSuccess) {
+        if (_reduction >= 0 && ((SciDBDataset*)poDS)->_reductions[_reduction] == "count") {
+            if (pbSuccess != NULL)
+                *pbSuccess = false;
+            return 1;
+        }
         string key = SCIDB4GDAL_DEFAULTMDFIELD_SCALE;
-        MD md = _array->attrs[nBand - 1].md[""]; // TODO: Add domain
+        MD md = _array->attrs[_attr].md[""]; // TODO: Add domain
         if (md.find(key) == md.end()) {
             if (pbSuccess != NULL)
                 *pbSuccess = false;
@@ -315,30 +865,67 @@ namespace scidb4gdal {
 
     const char* SciDBRasterBand::GetUnitType() {
         string key = SCIDB4GDAL_DEFAULTMDFIELD_UNIT;
-        MD md = _array->attrs[nBand - 1].md[""]; // TODO: Add domain
+        MD md = _array->attrs[_attr].md[""]; // TODO: Add domain
         if (md.find(key) == md.end()) {
             return "";
         }
         return md[key].c_str();
     }
 
+    /* =============================================
+    *  SciDBMaskBand
+    * =============================================
+    */
+    SciDBMaskBand::SciDBMaskBand(SciDBDataset* poDS) {
+        this->poDS = poDS;
+        this->nBand = 0;
+        nRasterXSize = poDS->GetRasterXSize();
+        nRasterYSize = poDS->GetRasterYSize();
+        eDataType = GDT_Byte;
+        poDS->GetRasterBand(1)->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    }
+
+    uint32_t SciDBMaskBand::getTileId(GDALDataset* poDS, int nBlockXOff, int nBlockYOff, int nBlockXSize, int nBlockYSize) {
+        int nx = (poDS->GetRasterXSize() + nBlockXSize - 1) / nBlockXSize;
+        int ny = (poDS->GetRasterYSize() + nBlockYSize - 1) / nBlockYSize;
+        // masks are stored as an additional band after all attributes
+        return TileCache::getBlockId(nBlockXOff, nBlockYOff, poDS->GetRasterCount(), nx, ny, poDS->GetRasterCount() + 1);
+    }
+
+    CPLErr SciDBMaskBand::IReadBlock(int nBlockXOff, int nBlockYOff, void* pImage) {
+        SciDBDataset* poGDS = (SciDBDataset*)poDS;
+        ArrayTile* cached = poGDS->_cache.get(getTileId(poDS, nBlockXOff, nBlockYOff, nBlockXSize, nBlockYSize));
+        if (cached) {
+            memcpy(pImage, cached->data, cached->size);
+            return CE_None;
+        }
+
+        // All attributes share empty cells, fetch the block of the first band
+        SciDBRasterBand* band = (SciDBRasterBand*)poGDS->GetRasterBand(1);
+        ArrayTile tile, mask;
+        if (band->fetchBlock(nBlockXOff, nBlockYOff, tile, mask) != CE_None)
+            return CE_Failure;
+        memcpy(pImage, mask.data, mask.size);
+        poGDS->cacheTile(tile);
+        poGDS->cacheTile(mask);
+        return CE_None;
+    }
+
     /* =============================================
     *  SciDBDataset
     * =============================================
     */
     SciDBDataset::SciDBDataset(SciDBSpatialArray& array, ShimClient* client)
-        : _array(array), _client(client) {
+        : _array(array), _client(client), papszMetadata(NULL), _connstr(""), papszSubDatasets(NULL), _tlow(-1), _thigh(-1), _tindex(-1), _arraykey(""), _maskBand(NULL), _statsApprox(false) {
         // TODO check if the +1 is really needed or if this leeds to the one pixel
         // borders
         this->nRasterXSize = 1 + _array.getXDim()->high - _array.getXDim()->low;
         this->nRasterYSize = 1 + _array.getYDim()->high - _array.getYDim()->low;
 
-        map<string, string> kv;
-
-        // TODO check if this is needed or if metadata is already stored in the array
-        // (it should be), this would save one unnecessary scidb call
-        _client->getArrayMD(kv, _array.name, ""); // get metadata of default domain
-        map<string, string>::const_iterator itr;
+        // metadata of the default domain has already been fetched along with the
+        // array descriptor (or has been copied from the source data set)
+        MD& kv = _array.md[""];
+        MD::const_iterator itr;
 
         // when constructing the data set set each of the stored metadata coming from
         // scidb
@@ -346,25 +933,67 @@ namespace scidb4gdal {
             this->SetMetadataItem((*itr).first.c_str(), (*itr).second.c_str());
         }
 
-        // Create GDAL Bands
-        for (uint32_t i = 0; i < _array.attrs.size(); ++i)
-            this->SetBand(i + 1, new SciDBRasterBand(this, &_array, i));
-
-        this->SetDescription(_array.toString().c_str());
-
         SciDBSpatialArray* arr_ptr = &this->_array;
         SciDBSpatioTemporalArray* st_arr_ptr = dynamic_cast<SciDBSpatioTemporalArray*>(arr_ptr);
+        bool range = st_arr_ptr && _client->_qp && _client->_qp->hasTemporalRange;
+        if (range) {
+            _tlow = _client->_qp->lower_bound;
+            _thigh = _client->_qp->upper_bound;
+        }
+        if (st_arr_ptr && _client->_qp && !_client->_qp->reductions.empty()) {
+            _reductions = _client->_qp->reductions;
+            if (!range) {
+                _tlow = st_arr_ptr->getTDim()->low;
+                _thigh = st_arr_ptr->getTDim()->high;
+            }
+        }
+
+        // Create GDAL Bands, temporal ranges get one band per time step and attribute,
+        // temporal reductions one band per attribute and reduction
+        if (!_reductions.empty()) {
+            int n = 1;
+            for (uint32_t i = 0; i < _array.attrs.size(); ++i) {
+                for (uint32_t r = 0; r < _reductions.size(); ++r, ++n) {
+                    SciDBRasterBand* band = new SciDBRasterBand(this, &_array, i, -1, r);
+                    this->SetBand(n, band);
+                    band->SetDescription((_array.attrs[i].name + " " + _reductions[r]).c_str());
+                    band->SetMetadataItem("REDUCTION", _reductions[r].c_str());
+                }
+            }
+        } else if (range) {
+            int n = 1;
+            vector<TPoint> times;
+            st_arr_ptr->datetimesAtIndexRange(_client->_qp->lower_bound, _client->_qp->upper_bound, times);
+            for (int t = _client->_qp->lower_bound; t <= _client->_qp->upper_bound; ++t) {
+                TPoint& time = times[t - _client->_qp->lower_bound];
+                time._resolution = st_arr_ptr->getTInterval()->_resolution;
+                for (uint32_t i = 0; i < _array.attrs.size(); ++i, ++n) {
+                    SciDBRasterBand* band = new SciDBRasterBand(this, &_array, i, t);
+                    this->SetBand(n, band);
+                    band->SetDescription((_array.attrs[i].name + " " + time.toStringISO()).c_str());
+                    band->SetMetadataItem("TIMESTAMP", time.toStringISO().c_str());
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < _array.attrs.size(); ++i)
+                this->SetBand(i + 1, new SciDBRasterBand(this, &_array, i));
+            if (!_array.attrs.empty())
+                _maskBand = new SciDBMaskBand(this);
+        }
+
+        this->SetDescription(_array.toString().c_str());
 
         // check if dynamic cast was successfull. if so then check for the temporal
         // index and then calculate the timestamp according to the resolution
         if (st_arr_ptr) {
-            int tmin = st_arr_ptr->getTDim()->low;
-            int tmax = st_arr_ptr->getTDim()->high;
+            int tmin = (_tlow >= 0) ? _tlow : st_arr_ptr->getTDim()->low;
+            int tmax = (_tlow >= 0) ? _thigh : st_arr_ptr->getTDim()->high;
             int tindex = -1;
-            if (_client->_qp->hasTemporalIndex) {
+            if (_client->_qp && _client->_qp->hasTemporalIndex) {
                 tindex = _client->_qp->temp_index; // TODO find the place where the
                 // temporal index is stored in the
                 // array
+                _tindex = tindex;
 
                 TPoint time = st_arr_ptr->datetimeAtIndex(tindex);
                 time._resolution = st_arr_ptr->getTInterval()->_resolution;
@@ -423,7 +1052,17 @@ namespace scidb4gdal {
 
     SciDBDataset::~SciDBDataset() {
         FlushCache();
-        delete _client;
+        delete _maskBand;
+        CSLDestroy(papszSubDatasets);
+    }
+
+    void SciDBDataset::cacheTile(const ArrayTile& tile) {
+        if (!tile.data) return;
+        _cache.add(tile);
+        // the tile has not been added if it is cached already or if it exceeds the cache size
+        ArrayTile* cached = _cache.get(tile.id);
+        if (!cached || cached->data != tile.data)
+            free(tile.data);
     }
 
     CPLErr SciDBDataset::GetGeoTransform(double* padfTransform) {
@@ -444,22 +1083,70 @@ namespace scidb4gdal {
 
     const char* SciDBDataset::GetProjectionRef() { return _array.srtext.c_str(); }
 
-    /*
-    char **SciDBDataset::GetMetadata ( const char *pszDomain )
-    {
-        map <string, string> kv;
-        if ( pszDomain == NULL ) {
-            _client->getArrayMD ( kv, _array.name, "" );
+    char** SciDBDataset::GetMetadata(const char* pszDomain) {
+        if (pszDomain == NULL || !EQUAL(pszDomain, "SUBDATASETS") || _connstr.empty())
+            return GDALDataset::GetMetadata(pszDomain);
+
+        if (papszSubDatasets != NULL) return papszSubDatasets;
+
+        SciDBSpatialArray* arr_ptr = &this->_array;
+        SciDBSpatioTemporalArray* st_arr_ptr = dynamic_cast<SciDBSpatioTemporalArray*>(arr_ptr);
+        if (!st_arr_ptr) return NULL;
+
+        // the subdataset names equal the connection string of this data set with a
+        // temporal index appended to the array name
+        string arraykey = "array=" + _array.name;
+        string prefix, suffix;
+        size_t pos = _connstr.find(arraykey);
+        if (pos != string::npos) {
+            pos += arraykey.length();
+            prefix = _connstr.substr(0, pos);
+            suffix = _connstr.substr(pos);
+        } else {
+            // the array name has been given as opening option, it is added to the connection string
+            size_t props = _connstr.find("properties=");
+            if (props == string::npos) {
+                // no blank after a bare "SCIDB:" prefix
+                prefix = _connstr + ((_connstr.length() > strlen("SCIDB:")) ? " " : "") + arraykey;
+            } else {
+                prefix = _connstr.substr(0, props) + arraykey;
+                suffix = " " + _connstr.substr(props);
+            }
         }
-        // DOMAINS NOT YET IMPLEMENTED
-    //         else {
-    //             _client->getArrayMD ( kv, _array.name, pszDomain );
-    //         }
 
-        //check if there are also
-        return mapToGdalMD ( kv );
+        SciDBDimension* tdim = st_arr_ptr->getTDim();
+        CPLStringList list;
+        int n = 1;
+        vector<TPoint> times;
+        st_arr_ptr->datetimesAtIndexRange((int)tdim->low, (int)tdim->high, times);
+        for (int64_t t = tdim->low; t <= tdim->high; ++t, ++n) {
+            stringstream name;
+            name << prefix << "[" << tdim->name << "," << t << "]" << suffix;
+
+            TPoint& time = times[t - tdim->low];
+            time._resolution = st_arr_ptr->getTInterval()->_resolution;
+            stringstream desc;
+            desc << _array.name << " at " << time.toStringISO() << " (" << tdim->name << "=" << t << ")";
+
+            list.AddNameValue(CPLSPrintf("SUBDATASET_%d_NAME", n), name.str().c_str());
+            list.AddNameValue(CPLSPrintf("SUBDATASET_%d_DESC", n), desc.str().c_str());
+        }
+        papszSubDatasets = list.StealList();
+        return papszSubDatasets;
+    }
+
+    char** SciDBDataset::GetMetadataDomainList() {
+        return BuildMetadataDomainList(GDALDataset::GetMetadataDomainList(), TRUE,
+                                       _connstr.empty() ? NULL : "SUBDATASETS", NULL);
     }
 
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 1, 0)
+    std::shared_ptr<GDALGroup> SciDBDataset::GetRootGroup() const {
+        return SciDBMDGroup::Create(_client, _array);
+    }
+#endif
+
+    /*
     const char *SciDBDataset::GetMetadataItem ( const char *pszName, const char
     *pszDomain )
     {
@@ -477,7 +1164,137 @@ namespace scidb4gdal {
     }
     */
 
-    ShimClient* SciDBDataset::getClient() { return _client; }
+    ShimClient* SciDBDataset::getClient() { return _client.get(); }
+
+    double SciDBDataset::statsSample() {
+        return _client->_qp ? _client->_qp->stats_sample : SCIDB4GDAL_DEFAULT_STATS_SAMPLE;
+    }
+
+    bool SciDBDataset::loadStatistics() {
+        const char* keys[] = {SCIDB4GDAL_DEFAULTMDFIELD_STATS_MIN, SCIDB4GDAL_DEFAULTMDFIELD_STATS_MAX,
+                              SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN, SCIDB4GDAL_DEFAULTMDFIELD_STATS_STDDEV};
+        vector<SciDBAttributeStats> stats(_array.attrs.size());
+        for (size_t i = 0; i < _array.attrs.size(); ++i) {
+            MD& md = _array.attrs[i].md[""];
+            double* fields[] = {&stats[i].min, &stats[i].max, &stats[i].mean, &stats[i].stdev};
+            for (int k = 0; k < 4; ++k) {
+                MD::iterator it = md.find(keys[k]);
+                if (it == md.end()) return false;
+                string value = it->second;
+                boost::algorithm::trim(value);
+                try {
+                    *fields[k] = boost::lexical_cast<double>(value);
+                } catch (boost::bad_lexical_cast&) {
+                    return false;
+                }
+                if (CPLIsNan(*fields[k])) return false; // outdated, see clearStatistics()
+            }
+        }
+        // approximate if any attribute is
+        bool approx = false;
+        for (size_t i = 0; i < _array.attrs.size(); ++i) {
+            MD& md = _array.attrs[i].md[""];
+            MD::iterator it = md.find(SCIDB4GDAL_DEFAULTMDFIELD_STATS_APPROX);
+            if (it != md.end() && CSLTestBoolean(it->second.c_str())) approx = true;
+        }
+        _stats = stats;
+        _statsApprox = approx;
+        return true;
+    }
+
+    StatusCode SciDBDataset::computeStatistics(bool approx) {
+        double sample = approx ? statsSample() : 1;
+
+        vector<SciDBAttributeStats> stats;
+        StatusCode res = _client->getAttributeStats(_array, stats, sample);
+        if (res != SUCCESS) return res;
+        if (sample < 1) {
+            // small arrays might not leave a single sampled cell
+            for (size_t i = 0; i < stats.size(); ++i) {
+                if (CPLIsNan(stats[i].mean)) {
+                    Utils::debug("Sample is too small for approximate statistics, computing exact statistics");
+                    sample = 1;
+                    res = _client->getAttributeStats(_array, stats);
+                    if (res != SUCCESS) return res;
+                    break;
+                }
+            }
+        }
+        _stats = stats;
+        _statsApprox = sample < 1;
+
+        // persist for later opens, bands without valid values are computed again
+        bool persist = _client->hasSCIDB4GEO();
+        for (size_t i = 0; i < _array.attrs.size(); ++i) {
+            if (CPLIsNan(stats[i].mean)) continue;
+            MD kv;
+            kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MIN] = CPLSPrintf("%.17g", stats[i].min);
+            kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MAX] = CPLSPrintf("%.17g", stats[i].max);
+            kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN] = CPLSPrintf("%.17g", stats[i].mean);
+            kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_STDDEV] = CPLSPrintf("%.17g", stats[i].stdev);
+            kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_APPROX] = _statsApprox ? "YES" : "NO";
+            MD& md = _array.attrs[i].md[""];
+            for (MD::iterator it = kv.begin(); it != kv.end(); ++it) md[it->first] = it->second;
+            if (persist && _client->setAttributeMD(_array.name, _array.attrs[i].name, kv) != SUCCESS)
+                persist = false; // no need to try the other attributes
+        }
+        return SUCCESS;
+    }
+
+    StatusCode SciDBDataset::computeSliceStatistics(int64_t t, bool approx) {
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(&_array);
+        if (!starray) return ERR_READ_UNKNOWN;
+
+        // all slices of a temporal range at once
+        int64_t t_min = t, t_max = t;
+        if (_tlow >= 0 && t >= _tlow && t <= _thigh) {
+            t_min = _tlow;
+            t_max = _thigh;
+        }
+        double sample = approx ? statsSample() : 1;
+        vector<vector<SciDBAttributeStats> > stats;
+        StatusCode res = _client->getAttributeStats(*starray, t_min, t_max, stats, sample);
+        if (res != SUCCESS) return res;
+        if (sample < 1) {
+            // small slices might not leave a single sampled cell
+            const vector<SciDBAttributeStats>& s = stats[t - t_min];
+            for (size_t i = 0; i < s.size(); ++i) {
+                if (CPLIsNan(s[i].mean)) {
+                    Utils::debug("Sample is too small for approximate statistics, computing exact statistics");
+                    sample = 1;
+                    res = _client->getAttributeStats(*starray, t_min, t_max, stats);
+                    if (res != SUCCESS) return res;
+                    break;
+                }
+            }
+        }
+        for (int64_t k = t_min; k <= t_max; ++k) {
+            SliceStats& s = _sliceStats[k];
+            if (!s.stats.empty() && !s.approx && sample < 1) continue; // keep exact statistics
+            s.stats = stats[k - t_min];
+            s.approx = sample < 1;
+        }
+        return SUCCESS;
+    }
+
+    void SciDBDataset::clearStatistics(ShimClient* client, SciDBSpatialArray& array) {
+        if (!client->hasSCIDB4GEO()) return;
+        for (size_t i = 0; i < array.attrs.size(); ++i) {
+            MD& md = array.attrs[i].md[""];
+            MD kv;
+            if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN) != md.end()) {
+                kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MIN] = "nan";
+                kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MAX] = "nan";
+                kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN] = "nan";
+                kv[SCIDB4GDAL_DEFAULTMDFIELD_STATS_STDDEV] = "nan";
+            }
+            if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS) != md.end())
+                kv[SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS] = "nan";
+            if (kv.empty()) continue;
+            for (MD::iterator it = kv.begin(); it != kv.end(); ++it) md[it->first] = it->second;
+            client->setAttributeMD(array.name, array.attrs[i].name, kv);
+        }
+    }
 
     void SciDBDataset::copyMetadataToArray(GDALDataset* poSrcDS,
                                         SciDBSpatialArray& array,
@@ -489,8 +1306,8 @@ namespace scidb4gdal {
         for (int i = 0; i < poSrcDS->GetRasterCount(); ++i) {
             SciDBAttribute a;
             a.nullable = false; // TODO
-            a.typeId = Utils::gdalTypeToSciDBTypeId(
-                poSrcDS->GetRasterBand(i + 1)->GetRasterDataType()); // All attribtues
+            a.setType(Utils::gdalTypeToSciDBTypeId(
+                poSrcDS->GetRasterBand(i + 1)->GetRasterDataType())); // All attribtues
             // must have the
             // same data type
             stringstream aname;
@@ -706,14 +1523,29 @@ namespace scidb4gdal {
                                                 SciDBSpatialArray& array,
                                                 GDALDataset* poSrcDS,
                                                 GDALProgressFunc pfnProgress,
-                                                void* pProgressData) {
+                                                void* pProgressData,
+                                                vector<BandAccumulator>* stats) {
         int nBands = poSrcDS->GetRasterCount();
         int nXSize = poSrcDS->GetRasterXSize();
         int nYSize = poSrcDS->GetRasterYSize();
 
+        // NODATA values of the bands are excluded from the statistics
+        vector<bool> hasNoData(nBands, false);
+        vector<double> noData(nBands, 0);
+        for (int i = 0; stats && i < nBands; ++i) {
+            MD& md = array.attrs[i].md[""];
+            MD::iterator it = md.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA);
+            if (it == md.end()) continue;
+            try {
+                noData[i] = boost::lexical_cast<double>(boost::algorithm::trim_copy(it->second));
+                hasNoData[i] = true;
+            } catch (boost::bad_lexical_cast&) {
+            }
+        }
+
         size_t pixelSize = 0;
         for (uint32_t i = 0; i < array.attrs.size(); ++i)
-            pixelSize += Utils::scidbTypeIdBytes(array.attrs[i].typeId);
+            pixelSize += array.attrs[i].type.bytes;
 
         size_t totalSize =
             pixelSize * array.getXDim()->chunksize * array.getYDim()->chunksize;
@@ -762,9 +1594,9 @@ namespace scidb4gdal {
                 // We assume reading whole blocks of individual bands first is more
                 // efficient than reading single band pixels subsequently
                 for (uint16_t iBand = 0; iBand < nBands; ++iBand) {
-                    void* blockBandBuf =
-                        malloc((1 + xmax - xmin) * (1 + ymax - ymin) *
-                            Utils::scidbTypeIdBytes(array.attrs[iBand].typeId));
+                    const SciDBTypeDesc& type = array.attrs[iBand].type;
+                    size_t nCells = (1 + xmax - xmin) * (1 + ymax - ymin);
+                    void* blockBandBuf = malloc(nCells * type.bytes);
 
                     // Using nPixelSpace and nLineSpace arguments could maybe automatically
                     // write to bandInterleavedChunk properly
@@ -775,22 +1607,19 @@ namespace scidb4gdal {
                     poBand->RasterIO(
                         GF_Read, xmin, ymin, 1 + xmax - xmin, 1 + ymax - ymin,
                         (void*)blockBandBuf, 1 + xmax - xmin, 1 + ymax - ymin,
-                        Utils::scidbTypeIdToGDALType(array.attrs[iBand].typeId), 0, 0,
+                        type.gdalType, 0, 0,
                         NULL);
 
+                    if (stats)
+                        Utils::accumulateBand((*stats)[iBand], blockBandBuf, nCells, type, hasNoData[iBand], noData[iBand]);
+
                     /* SciDB load file format is band interleaved by pixel / cell, whereas
                     common GDAL functions are rather band sequential. In the following, we perform
                     block-wise interleaving manually. */
 
-                    // Variable (unknown) data types and band numbers make this somewhat ugly
-                    for (int i = 0; i < (1 + xmax - xmin) * (1 + ymax - ymin); ++i) {
-                        memcpy(&((char*)bandInterleavedChunk)[i * pixelSize + bandOffset],
-                            &((char*)blockBandBuf)[i * Utils::scidbTypeIdBytes(
-                                                            array.attrs[iBand].typeId)],
-                            Utils::scidbTypeIdBytes(array.attrs[iBand].typeId));
-                    }
+                    Utils::interleaveBand(type.bytes, bandInterleavedChunk, (uint8_t*)blockBandBuf, nCells, pixelSize, bandOffset);
                     free(blockBandBuf);
-                    bandOffset += Utils::scidbTypeIdBytes(array.attrs[iBand].typeId);
+                    bandOffset += type.bytes;
                 }
 
                 if (client->insertData(array, bandInterleavedChunk, xmin, ymin, xmax,
@@ -809,6 +1638,47 @@ namespace scidb4gdal {
         free(bandInterleavedChunk);
     }
 
+    void SciDBDataset::statisticsToMD(const vector<BandAccumulator>& stats, SciDBSpatialArray& array) {
+        for (size_t i = 0; i < stats.size() && i < array.attrs.size(); ++i) {
+            const BandAccumulator& acc = stats[i];
+            if (acc.n == 0) continue;
+            MD& md = array.attrs[i].md[""];
+            md[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MIN] = CPLSPrintf("%.17g", acc.min);
+            md[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MAX] = CPLSPrintf("%.17g", acc.max);
+            md[SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN] = CPLSPrintf("%.17g", acc.mean);
+            md[SCIDB4GDAL_DEFAULTMDFIELD_STATS_STDDEV] = CPLSPrintf("%.17g", acc.stdev());
+            md[SCIDB4GDAL_DEFAULTMDFIELD_STATS_APPROX] = "NO";
+            if (acc.valueCounts.empty()) continue;
+
+            // rebin the value counts into the buckets of SciDBRasterBand::GetDefaultHistogram()
+            const int nBuckets = 256;
+            double hmin, hmax;
+            if (array.attrs[i].type.gdalType == GDT_Byte) {
+                hmin = -0.5;
+                hmax = 255.5;
+            } else {
+                double dfHalfBucket = (acc.max - acc.min) / (2 * (nBuckets - 1));
+                hmin = acc.min - dfHalfBucket;
+                hmax = acc.max + dfHalfBucket;
+                if (!(hmax > hmin)) hmax = hmin + 1;
+            }
+            const double scale = nBuckets / (hmax - hmin);
+            vector<uint64_t> counts(nBuckets, 0);
+            for (size_t k = 0; k < acc.valueCounts.size(); ++k) {
+                if (acc.valueCounts[k] == 0) continue;
+                int64_t b = (int64_t) floor(((double) ((int64_t) k + acc.valueOffset) - hmin) * scale);
+                if (b < 0) b = 0;
+                if (b >= nBuckets) b = nBuckets - 1;
+                counts[b] += acc.valueCounts[k];
+            }
+            stringstream s;
+            for (int b = 0; b < nBuckets; ++b) s << (b > 0 ? " " : "") << counts[b];
+            md[SCIDB4GDAL_DEFAULTMDFIELD_HIST_MIN] = CPLSPrintf("%.17g", hmin);
+            md[SCIDB4GDAL_DEFAULTMDFIELD_HIST_MAX] = CPLSPrintf("%.17g", hmax);
+            md[SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS] = s.str();
+        }
+    }
+
     bool SciDBDataset::arrayIntegrateable(SciDBSpatialArray& src_array, SciDBSpatialArray& tar_array) {
         bool sameSRS = (src_array.auth_srid == tar_array.auth_srid) &&  boost::iequals(src_array.auth_name, tar_array.auth_name);
 
@@ -879,6 +1749,261 @@ namespace scidb4gdal {
         return (sameSRS && isTPP);
     }
 
+    bool SciDBDataset::sliceAppendable(SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                       int64_t& dx, int64_t& dy, int64_t& t) {
+        if (options->timestamp.empty()) return false;
+
+        // uploaded tiles are written row by row, i.e. y must be the slower dimension
+        if (tar_array.getYDimIdx() > tar_array.getXDimIdx()) return false;
+
+        if (src_array.attrs.size() != tar_array.attrs.size()) return false;
+        for (uint32_t i = 0; i < src_array.attrs.size(); ++i) {
+            if (src_array.attrs[i].name != tar_array.attrs[i].name ||
+                src_array.attrs[i].typeId != tar_array.attrs[i].typeId ||
+                src_array.attrs[i].nullable != tar_array.attrs[i].nullable) return false;
+        }
+
+        // same cell size and orientation
+        const AffineTransform& s = src_array.affineTransform;
+        const AffineTransform& r = tar_array.affineTransform;
+        const double eps = 1e-9;
+        if (fabs(s._a11 - r._a11) > eps * fabs(r._a11) || fabs(s._a22 - r._a22) > eps * fabs(r._a22) ||
+            fabs(s._a12 - r._a12) > eps * (fabs(r._a11) + fabs(r._a12)) ||
+            fabs(s._a21 - r._a21) > eps * (fabs(r._a22) + fabs(r._a21))) return false;
+
+        // the image must be shifted by whole cells
+        AffineTransform::double2 p(src_array.getXDim()->low, src_array.getYDim()->low);
+        src_array.affineTransform.f(p);
+        tar_array.affineTransform.fInv(p);
+        double fx = floor(p.x + 0.5);
+        double fy = floor(p.y + 0.5);
+        if (fabs(p.x - fx) > 1e-6 || fabs(p.y - fy) > 1e-6) return false;
+        dx = (int64_t)fx - src_array.getXDim()->low;
+        dy = (int64_t)fy - src_array.getYDim()->low;
+
+        // the image must lie within the spatial dimensions of the target array, tiles are cut at its chunk grid
+        const SciDBDimension* xdim = tar_array.getXDim();
+        const SciDBDimension* ydim = tar_array.getYDim();
+        if (src_array.getXDim()->low + dx < xdim->start || src_array.getXDim()->high + dx > xdim->start + (int64_t)xdim->length - 1 ||
+            src_array.getYDim()->low + dy < ydim->start || src_array.getYDim()->high + dy > ydim->start + (int64_t)ydim->length - 1) {
+            Utils::debug("Image exceeds the spatial extent of the target array, coordinates are derived on the server");
+            return false;
+        }
+
+        TPoint time = TPoint(options->timestamp);
+        t = tar_array.indexAtDatetime(time);
+        return true;
+    }
+
+    StatusCode SciDBDataset::appendSlice(ShimClient* client, SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array, GDALDataset* poSrcDS,
+                                         int64_t dx, int64_t dy, int64_t t, GDALProgressFunc pfnProgress, void* pProgressData) {
+        // temporary array with the schema of the target
+        SciDBSpatioTemporalArray slice(tar_array);
+        slice.name = tar_array.name + SCIDB4GDAL_ARRAYSUFFIX_SLICE;
+        if (client->createTempArray(slice) != SUCCESS) return ERR_CREATE_TEMPARRAY;
+        slice.name = slice.name + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+
+        StatusCode res = uploadImageIntoSlice(client, slice, src_array, poSrcDS, dx, dy, t, pfnProgress, pProgressData);
+        if (res != SUCCESS) {
+            client->removeArray(slice.name);
+            if (res == ERR_CREATE_TERMINATEDBYUSER) throw res;
+            return res;
+        }
+
+        // a single new version of the target array per image
+        res = client->appendArray(slice.name, tar_array.name);
+        client->removeArray(slice.name);
+        return res;
+    }
+
+    StatusCode SciDBDataset::uploadImageIntoSlice(ShimClient* client, SciDBSpatioTemporalArray& slice, SciDBSpatialArray& src_array, GDALDataset* poSrcDS,
+                                                  int64_t dx, int64_t dy, int64_t t, GDALProgressFunc pfnProgress, void* pProgressData) {
+        TileReader reader(slice);
+        reader.add(poSrcDS, src_array.getXDim()->low + dx, src_array.getYDim()->low + dy);
+        return uploadTilesIntoSlice(client, slice, src_array, reader, t, pfnProgress, pProgressData);
+    }
+
+    StatusCode SciDBDataset::uploadTilesIntoSlice(ShimClient* client, SciDBSpatioTemporalArray& slice, SciDBSpatialArray& src_array, TileReader& reader,
+                                                  int64_t t, GDALProgressFunc pfnProgress, void* pProgressData) {
+        // attributes carry the NODATA values of the image
+        for (uint32_t i = 0; i < slice.attrs.size(); ++i) slice.attrs[i].md = src_array.attrs[i].md;
+
+        // tiles follow the chunk grid of the target array, so that every tile touches a single chunk
+        ImageTile tile;
+        while (reader.next(tile)) {
+            if (!pfnProgress((double)tile.iTile / (double)tile.nTiles, NULL, pProgressData)) {
+                Utils::debug("Interruption by user requested, trying to clean up");
+                free(tile.data);
+                return ERR_CREATE_TERMINATEDBYUSER;
+            }
+            StatusCode res = client->insertSlice(slice, tile.data, t, (int32_t)tile.xmin, (int32_t)tile.ymin, (int32_t)tile.xmax, (int32_t)tile.ymax);
+            free(tile.data);
+            if (res != SUCCESS) return ERR_CREATE_UNKNOWN;
+        }
+        if (tile.failed) {
+            Utils::error("Cannot read image for the upload into a temporal slice");
+            return ERR_CREATE_UNKNOWN;
+        }
+        return SUCCESS;
+    }
+
+    bool SciDBDataset::readSourceList(const string& listfile, vector<string>& files, vector<string>& timestamps) {
+        VSILFILE* fp = VSIFOpenL(listfile.c_str(), "r");
+        if (fp == NULL) return false;
+        const char* pszLine;
+        while ((pszLine = CPLReadLineL(fp)) != NULL) {
+            string line = pszLine;
+            boost::algorithm::trim(line);
+            if (line.empty() || line[0] == '#') continue;
+            // optional timestamp after the last semicolon, otherwise the TIMESTAMP metadata item of the image is used
+            size_t pos = line.rfind(';');
+            if (pos == string::npos) {
+                files.push_back(line);
+                timestamps.push_back("");
+            } else {
+                files.push_back(boost::algorithm::trim_copy(line.substr(0, pos)));
+                timestamps.push_back(boost::algorithm::trim_copy(line.substr(pos + 1)));
+            }
+        }
+        VSIFCloseL(fp);
+        return true;
+    }
+
+    void SciDBDataset::prepareSource(const string& file, const string& timestamp, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                     SourceImage& out) {
+        out.poSrcDS = (GDALDataset*)GDALOpen(file.c_str(), GA_ReadOnly);
+        if (out.poSrcDS == NULL) {
+            Utils::warn("Cannot open '" + file + "', skipping image");
+            out.res = ERR_CREATE_UNKNOWN;
+            return;
+        }
+
+        CreationParameters image_pars = *options;
+        image_pars.timestamp = timestamp;
+        image_pars.dt = timestamp.empty() ? "" : tar_array.getTInterval()->toStringISO();
+        SciDBSpatioTemporalArray& src = out.src;
+        if (!image_pars.timestamp.empty()) src.createTRS(image_pars.timestamp, image_pars.dt);
+        src.name = tar_array.name;
+        copyMetadataToArray(out.poSrcDS, src, &image_pars); // takes the timestamp from the metadata if not given in the list
+        src.getTDim()->start = 0;
+        src.getTDim()->low = 0;
+        src.getTDim()->high = SCIDB_MAX_DIM_INDEX;
+        src.getTDim()->length = SCIDB_MAX_DIM_INDEX - 0 + 1;
+
+        out.res = SUCCESS;
+        if (image_pars.timestamp.empty()) {
+            Utils::warn("No timestamp for '" + file + "', skipping image");
+            out.res = ERR_CREATE_UNKNOWN;
+        } else if (!arrayIntegrateable(src, tar_array)) {
+            Utils::warn("'" + file + "' is not insertable into the target array, skipping image");
+            out.res = ERR_CREATE_ARRAY_NOT_INSERTABLE;
+        } else {
+            out.appendable = sliceAppendable(src, tar_array, &image_pars, out.dx, out.dy, out.t);
+        }
+    }
+
+    StatusCode SciDBDataset::ingestSources(ShimClient* client, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                           const vector<string>& files, const vector<string>& timestamps,
+                                           GDALProgressFunc pfnProgress, void* pProgressData) {
+        if (files.empty()) return SUCCESS;
+
+        // all images on the grid of the target share one temporary array and are inserted with a single operation
+        SciDBSpatioTemporalArray slice(tar_array);
+        slice.name = tar_array.name + SCIDB4GDAL_ARRAYSUFFIX_SLICE;
+        if (client->createTempArray(slice) != SUCCESS) return ERR_CREATE_TEMPARRAY;
+        slice.name = slice.name + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+
+        // images are opened one ahead, the reader converts the next image while the current one is uploaded
+        vector<SourceImage> images(files.size());
+        TileReader* reader = new TileReader(slice);
+        prepareSource(files[0], timestamps[0], tar_array, options, images[0]);
+        if (images[0].res == SUCCESS && images[0].appendable)
+            reader->add(images[0].poSrcDS, images[0].src.getXDim()->low + images[0].dx, images[0].src.getYDim()->low + images[0].dy);
+
+        int nFailed = 0;
+        int nSlices = 0;
+        StatusCode res = SUCCESS;
+        size_t i = 0;
+        for (; i < files.size(); ++i) {
+            if (i + 1 < files.size()) {
+                SourceImage& following = images[i + 1];
+                prepareSource(files[i + 1], timestamps[i + 1], tar_array, options, following);
+                if (following.res == SUCCESS && following.appendable)
+                    reader->add(following.poSrcDS, following.src.getXDim()->low + following.dx, following.src.getYDim()->low + following.dy);
+            }
+
+            SourceImage& image = images[i];
+            if (image.poSrcDS == NULL) {
+                ++nFailed;
+                continue;
+            }
+            // the first share of the progress belongs to the image passed to CreateCopy()
+            void* pScaled = GDALCreateScaledProgress((double)(i + 1) / (files.size() + 1), (double)(i + 2) / (files.size() + 1), pfnProgress, pProgressData);
+
+            SciDBSpatioTemporalArray& src = image.src;
+            res = image.res;
+            if (res != SUCCESS) {
+                // skipped with a warning by prepareSource()
+            } else if (image.appendable) {
+                Utils::debug("Uploading '" + files[i] + "' as temporal slice " + boost::lexical_cast<string>(image.t));
+                res = uploadTilesIntoSlice(client, slice, src, *reader, image.t, GDALScaledProgress, pScaled);
+                if (res == SUCCESS) {
+                    ++nSlices;
+                } else if (res != ERR_CREATE_TERMINATEDBYUSER) {
+                    // tiles of the image already in the shared slice cannot be taken back, nothing is inserted
+                    Utils::error("Uploading '" + files[i] + "' failed, aborting the ingestion of all images");
+                    GDALDestroyScaledProgress(pScaled);
+                    break;
+                }
+            } else {
+                // images on a different grid need their coordinates computed by eo_over
+                string insertableName = tar_array.name + "_insertable";
+                src.name = insertableName;
+                if (client->createTempArray(src) != SUCCESS) {
+                    res = ERR_CREATE_TEMPARRAY;
+                } else {
+                    try {
+                        uploadImageIntoTempArray(client, src, image.poSrcDS, GDALScaledProgress, pScaled);
+                        src.name = insertableName + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+                        client->updateSRS(src);
+                        client->updateTRS(src);
+                        res = client->insertInto(src, tar_array);
+                        client->removeArray(src.name);
+                    } catch (StatusCode e) {
+                        res = e;
+                    }
+                }
+            }
+            GDALClose(image.poSrcDS);
+            image.poSrcDS = NULL;
+            GDALDestroyScaledProgress(pScaled);
+
+            if (res == ERR_CREATE_TERMINATEDBYUSER) break;
+            if (res != SUCCESS) ++nFailed;
+        }
+
+        // the reader stops before images it may still read are closed
+        delete reader;
+        for (size_t k = 0; k < images.size(); ++k) {
+            if (images[k].poSrcDS != NULL) GDALClose(images[k].poSrcDS);
+        }
+        if (i < files.size()) {
+            client->removeArray(slice.name);
+            if (res == ERR_CREATE_TERMINATEDBYUSER) throw res;
+            return res;
+        }
+
+        res = SUCCESS;
+        if (nSlices > 0) {
+            Utils::debug("Inserting " + boost::lexical_cast<string>(nSlices) + " temporal slices into '" + tar_array.name + "'");
+            res = client->appendArray(slice.name, tar_array.name);
+        }
+        client->removeArray(slice.name);
+
+        if (nFailed > 0) Utils::warn(boost::lexical_cast<string>(nFailed) + " of " + boost::lexical_cast<string>(files.size()) + " images could not be appended");
+        return res;
+    }
+
     GDALDataset* SciDBDataset::CreateCopy(const char* pszFilename,
                                         GDALDataset* poSrcDS, int bStrict,
                                         char** papszOptions,
@@ -894,6 +2019,10 @@ namespace scidb4gdal {
         ShimClient* client;
         SciDBSpatialArray* src_array;
         SciDBSpatialArray* tar_arr;
+        vector<string> sources, source_timestamps;
+        GDALProgressFunc pfnOrigProgress = pfnProgress;
+        void* pOrigProgressData = pProgressData;
+        void* pScaledProgress = NULL;
 
         try {
             Utils::debug("** Parse options and parameters **");
@@ -921,6 +2050,25 @@ namespace scidb4gdal {
 
             // 3. create client and set parameters
             client = new ShimClient(con_pars); // connection parameters are set
+
+            // cached descriptors of the target array become stale
+            ArrayDescCache::remove(*con_pars, con_pars->arrayname);
+            ReadAhead::remove(*con_pars, con_pars->arrayname);
+
+            // further images to append after the source image
+            if (!create_pars->sources.empty()) {
+                if (create_pars->type != ST_SERIES) {
+                    Utils::warn("SOURCES needs type=STS, ignoring the list of images");
+                } else if (!readSourceList(create_pars->sources, sources, source_timestamps)) {
+                    Utils::error("Cannot read the list of images '" + create_pars->sources + "'");
+                    throw ERR_GLOBAL_PARSE;
+                }
+            }
+            if (!sources.empty()) {
+                pScaledProgress = GDALCreateScaledProgress(0, 1.0 / (sources.size() + 1), pfnOrigProgress, pOrigProgressData);
+                pfnProgress = GDALScaledProgress;
+                pProgressData = pScaledProgress;
+            }
             
             client->setCreateParameters(*create_pars); // create parameters regarding time
            
@@ -1121,6 +2269,27 @@ namespace scidb4gdal {
             }
             Utils::debug("-- DONE");
 
+            // images on the grid of an existing ST_SERIES array are uploaded with their target coordinates, without eo_over
+            if (exists && create_pars->type == ST_SERIES && !create_pars->batch) {
+                SciDBSpatioTemporalArray* st_tar = dynamic_cast<SciDBSpatioTemporalArray*>(tar_arr);
+                int64_t dx, dy, t;
+                if (st_tar && sliceAppendable(*src_array, *st_tar, create_pars, dx, dy, t)) {
+                    Utils::debug("** Appending the image as temporal slice " + boost::lexical_cast<string>(t) + " of the target array **");
+                    StatusCode res = appendSlice(client, *src_array, *st_tar, poSrcDS, dx, dy, t, pfnProgress, pProgressData);
+                    if (res != SUCCESS) throw res;
+                    Utils::debug("-- DONE");
+                    pfnProgress(1.0, NULL, pProgressData);
+                    delete src_array;
+                    src_array = tar_arr;
+                    if (pScaledProgress) GDALDestroyScaledProgress(pScaledProgress);
+                    pScaledProgress = NULL;
+                    if (ingestSources(client, *st_tar, create_pars, sources, source_timestamps, pfnOrigProgress, pOrigProgressData) != SUCCESS)
+                        Utils::warn("Appending the images of '" + create_pars->sources + "' failed");
+                    clearStatistics(client, *tar_arr);
+                    return new SciDBDataset(*tar_arr, client);
+                }
+            }
+
             string arrayName = src_array->name;
             string tempArrayName = src_array->name + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
             string insertableName = src_array->name + "_insertable";
@@ -1144,7 +2313,23 @@ namespace scidb4gdal {
             // temporary
             // Copy data and write to SciDB as a temporary array
             Utils::debug("** Upload the source image into the temporary array **");
-            uploadImageIntoTempArray(client, *src_array, poSrcDS, pfnProgress, pProgressData);
+            // a new array holds only this image, its statistics are gathered while uploading
+            vector<BandAccumulator> upload_stats;
+            bool collect_stats = !exists && sources.empty();
+            if (collect_stats) {
+                upload_stats.resize(nBands);
+                for (int i = 0; create_pars->histogram && i < nBands; ++i) {
+                    const SciDBTypeDesc& type = src_array->attrs[i].type;
+                    if (!type.isInteger || type.bytes > 2) continue;
+                    upload_stats[i].valueCounts.resize((size_t) 1 << (8 * type.bytes), 0);
+                    upload_stats[i].valueOffset = type.isSigned ? -(1 << (8 * type.bytes - 1)) : 0;
+                }
+            }
+            uploadImageIntoTempArray(client, *src_array, poSrcDS, pfnProgress, pProgressData, collect_stats ? &upload_stats : NULL);
+            if (collect_stats) {
+                statisticsToMD(upload_stats, *src_array);
+                if (tar_arr != src_array) statisticsToMD(upload_stats, *tar_arr);
+            }
             Utils::debug("-- DONE");
 
             if (src_array == tar_arr) {
@@ -1206,8 +2391,17 @@ namespace scidb4gdal {
                     }
                 }
 
-                // insert data into target array
-                client->insertInto(*src_array, *tar_arr);
+                // insert data into target array, or into its staging array when appending in batches
+                if (exists && create_pars->batch && create_pars->type == ST_SERIES &&
+                    dynamic_cast<SciDBSpatioTemporalArray*>(tar_arr)) {
+                    StatusCode stage_res = stageImage(client, *src_array, *((SciDBSpatioTemporalArray*)tar_arr), create_pars);
+                    if (stage_res != SUCCESS) {
+                        client->removeArray(src_array->name); // insertable
+                        throw stage_res;
+                    }
+                } else {
+                    client->insertInto(*src_array, *tar_arr);
+                }
                 client->removeArray(src_array->name); // insertable
 
                 // persist target array
@@ -1250,6 +2444,12 @@ namespace scidb4gdal {
             }
 
             pfnProgress(1.0, NULL, pProgressData);
+            if (pScaledProgress) GDALDestroyScaledProgress(pScaledProgress);
+            pScaledProgress = NULL;
+            SciDBSpatioTemporalArray* st_arr = dynamic_cast<SciDBSpatioTemporalArray*>(src_array);
+            if (st_arr && ingestSources(client, *st_arr, create_pars, sources, source_timestamps, pfnOrigProgress, pOrigProgressData) != SUCCESS)
+                Utils::warn("Appending the images of '" + create_pars->sources + "' failed");
+            if (exists) clearStatistics(client, *src_array);
 
             if (tar_arr && tar_arr != src_array)
                 delete tar_arr;
@@ -1318,6 +2518,8 @@ namespace scidb4gdal {
                     Utils::error("Uncaught error: " + boost::lexical_cast<string>(e));
                     break;
             }
+            if (pScaledProgress)
+                GDALDestroyScaledProgress(pScaledProgress);
             if (client)
                 delete client;
             if (con_pars)
@@ -1333,6 +2535,70 @@ namespace scidb4gdal {
         }
     }
 
+    StatusCode SciDBDataset::stageImage(ShimClient* client, SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array,
+                                        CreationParameters* options) {
+        if (options->timestamp.empty()) {
+            Utils::warn("Batched appends need the timestamp of the image, inserting it directly");
+            return client->insertInto(src_array, tar_array);
+        }
+        SciDBDimension* tdim = tar_array.getTDim();
+        const int64_t cs = (tdim->chunksize > 0) ? tdim->chunksize : 1;
+        TPoint time = TPoint(options->timestamp);
+        const int64_t t = tar_array.indexAtDatetime(time);
+        if (t < tdim->start || t > tdim->start + (int64_t) tdim->length - 1) {
+            Utils::error("Timestamp '" + options->timestamp + "' is outside of the temporal dimension of '" + tar_array.name + "'");
+            return ERR_CREATE_ARRAY_NOT_INSERTABLE;
+        }
+        const int64_t chunk = Utils::floorDiv(t - tdim->start, cs);
+        const string stagingName = tar_array.name + SCIDB4GDAL_ARRAYSUFFIX_STAGING + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+
+        bool exists = false;
+        StatusCode res = client->arrayExists(stagingName, exists);
+        if (res != SUCCESS) return res;
+        if (exists) {
+            // dimension bounds of the staging array are the bounds of the staged images
+            SciDBSpatialArray* staged = NULL;
+            if (client->getArrayDesc(stagingName, staged) == SUCCESS && staged) {
+                SciDBSpatioTemporalArray* ststaged = dynamic_cast<SciDBSpatioTemporalArray*>(staged);
+                if (ststaged && Utils::floorDiv(ststaged->getTDim()->low - tdim->start, cs) != chunk) {
+                    Utils::debug("Inserting staged images of a previous temporal chunk into '" + tar_array.name + "'");
+                    res = client->appendArray(stagingName, tar_array.name);
+                    if (res != SUCCESS) {
+                        delete staged;
+                        return res;
+                    }
+                    client->removeArray(stagingName);
+                    exists = false;
+                }
+                delete staged;
+            }
+        }
+
+        SciDBSpatioTemporalArray staging(tar_array);
+        if (!exists) {
+            staging.name = tar_array.name + SCIDB4GDAL_ARRAYSUFFIX_STAGING;
+            if (client->createTempArray(staging) != SUCCESS) return ERR_CREATE_TEMPARRAY;
+            staging.name = stagingName;
+            client->updateSRS(staging);
+            client->updateTRS(staging);
+        }
+        staging.name = stagingName;
+
+        res = client->insertInto(src_array, staging);
+        if (res != SUCCESS) return res;
+
+        // insert the staged images once the temporal chunk is complete
+        if (options->flush || t - tdim->start - chunk * cs == cs - 1) {
+            Utils::debug("Inserting staged images into '" + tar_array.name + "'");
+            res = client->appendArray(stagingName, tar_array.name);
+            if (res != SUCCESS) return res;
+            client->removeArray(stagingName);
+        } else {
+            Utils::debug("Image has been staged, it will be inserted into '" + tar_array.name + "' once the temporal chunk is complete");
+        }
+        return SUCCESS;
+    }
+
     CPLErr SciDBDataset::Delete(const char* pszName) {
         try {
             ParameterParser p = ParameterParser(pszName, NULL, SCIDB_DELETE);
@@ -1340,8 +2606,16 @@ namespace scidb4gdal {
 
             if (c.isValid() && c.deleteArray) {
                 Utils::debug("Deleting array: " + c.arrayname);
+                ArrayDescCache::remove(c, c.arrayname);
+                ReadAhead::remove(c, c.arrayname);
                 ShimClient client = ShimClient(&c);
                 client.removeArray(c.arrayname);
+
+                // drop images that have been staged but not yet inserted
+                bool staged = false;
+                string stagingName = c.arrayname + SCIDB4GDAL_ARRAYSUFFIX_STAGING + SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+                if (client.arrayExists(stagingName, staged) == SUCCESS && staged)
+                    client.removeArray(stagingName);
             }
         } catch (StatusCode e) {
             Utils::debug("Error while deleting. Cannot delete image. Continuing.");
@@ -1394,29 +2668,41 @@ namespace scidb4gdal {
 
             // 3. Create shim client
             ShimClient* client = new ShimClient(con_pars);
-            
-            //  Check whether scidb4geo is installed and stop impossible operations
-            if (!client->hasSCIDB4GEO()) {
-                if (query_pars->timestamp.length() > 0) {  
-                    Utils::error("Downloading temporal slices with given timestamp needs SciDB spacetime extension. Please install the extension on the SciDB server.");
-                    throw ERR_GLOBAL_NO_SCIDB4GEO;
-                }
-            }
-            
-            
 
-            client->setQueryParameters(*query_pars);
-            
-
-            // create simple array here and cast it later if needed
-            SciDBSpatialArray* array;
-            // 4. Request array metadata
-            if (client->getArrayDesc(con_pars->arrayname, array) != SUCCESS) {
-                Utils::error("Cannot fetch array metadata");
-                return NULL;
+            // Temporal slices (e.g. SUBDATASETS) reuse the descriptor of a previously
+            // opened slice as long as the array has not been modified. Only they query
+            // the array version, which also keys their read-ahead buffers.
+            bool sliced = query_pars->hasTemporalIndex || query_pars->hasTemporalRange || query_pars->timestamp.length() > 0;
+            string version;
+            bool versioned = sliced && client->getArrayVersion(con_pars->arrayname, version) == SUCCESS;
+            SciDBSpatialArray* array = NULL;
+            if (sliced && versioned) {
+                array = ArrayDescCache::get(*con_pars, con_pars->arrayname, version);
+                if (array) Utils::debug("Using cached array descriptor of " + con_pars->arrayname);
             }
+
             if (!array) {
-                Utils::debug("array changes not afflicting the 'scidbdriver'");
+                //  Check whether scidb4geo is installed and stop impossible operations
+                if (!client->hasSCIDB4GEO()) {
+                    if (query_pars->timestamp.length() > 0) {
+                        Utils::error("Downloading temporal slices with given timestamp needs SciDB spacetime extension. Please install the extension on the SciDB server.");
+                        throw ERR_GLOBAL_NO_SCIDB4GEO;
+                    }
+                }
+
+                // 4. Request array metadata
+                if (client->getArrayDesc(con_pars->arrayname, array) != SUCCESS) {
+                    Utils::error("Cannot fetch array metadata");
+                    return NULL;
+                }
+                if (!array) {
+                    Utils::debug("array changes not afflicting the 'scidbdriver'");
+                }
+                if (SciDBSpatioTemporalArray* st = dynamic_cast<SciDBSpatioTemporalArray*>(array)) {
+                    // monthly and yearly arrays get their timestamps tabulated once, the cached copy keeps them
+                    st->precomputeIndexTable((int)st->getTDim()->low, (int)st->getTDim()->high);
+                    if (versioned) ArrayDescCache::put(*con_pars, *array, version);
+                }
             }
 
             // try to cast the array. if not possible then it is null and the temporal
@@ -1425,16 +2711,17 @@ namespace scidb4gdal {
             if (starray_ptr) {
                 Utils::debug("Type Cast OK. Start setting up temporal information");
                 // check if the temporal index was set or if a timestamp was used
-                if (query_pars->hasTemporalIndex) {
-                    Utils::debug("Has index...");
-                    char* t_index_key = new char[1];
-                    t_index_key[0] = 't';
-                    if (CSLFindName(poOpenInfo->papszOpenOptions, t_index_key) >= 0) {
-                        string value = CSLFetchNameValue(poOpenInfo->papszOpenOptions, t_index_key);
-                        Utils::debug("Casting temporal index");
-                        query_pars->temp_index = boost::lexical_cast<int>(value);
-                        Utils::debug("done");
+                if (query_pars->hasTemporalRange) {
+                    // convert a date/time interval to temporal indexes
+                    if (query_pars->timestamp_end.length() > 0) {
+                        TPoint start = TPoint(query_pars->timestamp);
+                        TPoint end = TPoint(query_pars->timestamp_end);
+                        query_pars->lower_bound = starray_ptr->indexAtDatetime(start);
+                        query_pars->upper_bound = starray_ptr->indexAtDatetime(end);
                     }
+                } else if (query_pars->hasTemporalIndex) {
+                    // the index has been parsed from the array name or the opening options
+                    Utils::debug("Has index...");
                 } else {
                     // convert date to temporal index
                     Utils::debug("Converting date to index");
@@ -1469,6 +2756,19 @@ namespace scidb4gdal {
                         return NULL;
                     }
                 } 
+                if (query_pars->hasTemporalRange) {
+                    if (query_pars->lower_bound > query_pars->upper_bound ||
+                        query_pars->lower_bound < dim->low ||
+                        query_pars->upper_bound > dim->high) {
+                        Utils::error(
+                            "Specified temporal range invalid or out of bounds: " +
+                            boost::lexical_cast<string>(query_pars->lower_bound) + ":" +
+                            boost::lexical_cast<string>(query_pars->upper_bound) +
+                            ", Lower bound: " + boost::lexical_cast<string>(dim->low) +
+                            ", Upper bound: " + boost::lexical_cast<string>(dim->high));
+                        return NULL;
+                    }
+                }
                 /*else {
                     //set the temporal index to 0 (the first one, if no query parameter was stated)
                     query_pars->temp_index = starray_ptr->getTDim()->low;
@@ -1476,16 +2776,36 @@ namespace scidb4gdal {
                 }*/
             }
 
-            // Create the dataset
+            else if (query_pars->hasTemporalRange) {
+                Utils::warn("Array has no temporal dimension, temporal range is ignored");
+                query_pars->hasTemporalRange = false;
+            }
+            if (!query_pars->reductions.empty() && (!starray_ptr || query_pars->hasTemporalIndex)) {
+                Utils::warn("Temporal reductions need a spatio-temporal array without temporal slice and are ignored");
+                query_pars->reductions.clear();
+            }
+
+            // Create the dataset, the client copies the final query parameters
 
+            client->setQueryParameters(*query_pars);
             SciDBDataset* poDS;
             poDS = new SciDBDataset(*array, client);
+            if (starray_ptr && !query_pars->hasTemporalIndex && !query_pars->hasTemporalRange && query_pars->reductions.empty()) {
+                poDS->_connstr = connstr;
+            }
+            if (starray_ptr && query_pars->hasTemporalIndex && versioned && ReadAhead::budget() > 0) {
+                // slices buffered from other versions of the array are never used
+                poDS->_arraykey = ReadAhead::arrayKey(*con_pars, con_pars->arrayname, version);
+            }
             return (poDS);
         } catch (int e) {
             switch (e) {
                 case ERR_GLOBAL_PARSE:
                     Utils::error("This is not a scidb4gdal connection string");
                     break;
+                case ERR_GLOBAL_INVALIDOPTION:
+                    // the option and its value have been reported by the parser
+                    break;
                 case ERR_READ_ARRAYUNKNOWN:
                     Utils::error("Array name missing");
                     break;
@@ -26,9 +26,11 @@ SOFTWARE.
 #define SCIDB_DRIVER_H
 
 #include <iostream>
+#include <boost/shared_ptr.hpp>
 #include "utils.h"
 #include "shimclient.h"
 #include "tilecache.h"
+#include "tilereader.h"
 #include "TemporalReference.h"
 
 namespace scidb4gdal {
@@ -36,6 +38,7 @@ namespace scidb4gdal {
 
     class SciDBRasterBand;
     class SciDBDataset;
+    class SciDBMaskBand;
 
     /**
     * @brief GDALDataset subclass implementing core GDAL functionality
@@ -50,6 +53,7 @@ namespace scidb4gdal {
     */
     class SciDBDataset : public GDALDataset {
         friend class SciDBRasterBand;
+        friend class SciDBMaskBand;
 
     private:
         /**
@@ -59,9 +63,10 @@ namespace scidb4gdal {
         SciDBSpatialArray& _array;
         
         /**
-        * pointer to Shim client class that is used to interact with the SciDB
+        * Shim client class that is used to interact with the SciDB, shared with the
+        * multidimensional root group
         */
-        ShimClient* _client;
+        boost::shared_ptr<ShimClient> _client;
         
         /**
         * the tile cache used for downloading chunked array data and to temporarily
@@ -76,6 +81,90 @@ namespace scidb4gdal {
         */
         char** papszMetadata;
 
+        /**
+        * The connection string the data set was opened with. It is only set for
+        * spatio-temporal arrays that were opened without a temporal slice and
+        * serves as template for the names of the SUBDATASETS.
+        */
+        string _connstr;
+
+        /**
+        * Lazily built SUBDATASETS metadata domain listing the temporal slices
+        */
+        char** papszSubDatasets;
+
+        /** lower temporal index if the data set represents a temporal range, -1 otherwise */
+        int _tlow;
+        /** upper temporal index if the data set represents a temporal range, -1 otherwise */
+        int _thigh;
+
+        /** temporal reductions exposed as bands, computed over [_tlow, _thigh] */
+        vector<string> _reductions;
+
+        /** temporal index if the data set represents a single temporal slice, -1 otherwise */
+        int _tindex;
+
+        /** key of the array version for temporal read-ahead, see scidb4gdal::ReadAhead, empty if read-ahead is not used */
+        string _arraykey;
+
+        /** mask of empty cells shared by all bands, NULL if bands represent a temporal range or reductions */
+        SciDBMaskBand* _maskBand;
+
+        /**
+        * @brief Adds a tile to the tile cache, or releases its memory if it cannot be cached
+        */
+        void cacheTile(const ArrayTile& tile);
+
+        /** statistics of all attributes, empty until they have been read from the attribute metadata or computed */
+        vector<SciDBAttributeStats> _stats;
+
+        /** whether _stats have been computed from a sample of the cells */
+        bool _statsApprox;
+
+        /** statistics of all attributes of a temporal slice */
+        struct SliceStats {
+            vector<SciDBAttributeStats> stats;
+            /** whether the statistics have been computed from a sample of the cells */
+            bool approx;
+
+            SliceStats() : approx(false) {}
+        };
+
+        /** statistics of temporal slices by temporal index, computed on demand */
+        map<int64_t, SliceStats> _sliceStats;
+
+        /**
+        * @brief Returns the fraction of cells sampled for approximate statistics and histograms
+        */
+        double statsSample();
+
+        /**
+        * @brief Reads the statistics of all attributes from their metadata
+        *
+        * @return true if every attribute has persisted statistics
+        */
+        bool loadStatistics();
+
+        /**
+        * @brief Computes the statistics of all attributes with a single query and persists them as attribute metadata
+        *
+        * @param approx sample cells at the rate of the opening option 'stats_sample' instead of aggregating all cells
+        * @return scidb4gdal::StatusCode
+        */
+        StatusCode computeStatistics(bool approx);
+
+        /**
+        * @brief Computes the statistics of all attributes of a temporal slice with a single query
+        *
+        * If the data set represents a temporal range that contains the slice, the statistics of all slices of the range are computed by
+        * the same query. Results are cached in _sliceStats, they are not persisted.
+        *
+        * @param t the temporal index
+        * @param approx sample cells at the rate of the opening option 'stats_sample' instead of aggregating all cells
+        * @return scidb4gdal::StatusCode
+        */
+        StatusCode computeSliceStatistics(int64_t t, bool approx);
+
     public:
         /**
         * @brief The constructor of a SciDBDataset
@@ -139,11 +228,34 @@ namespace scidb4gdal {
         /**
         * @brief Fetch Metadata for a domain.
         *
+        * Besides the default domain, spatio-temporal arrays that are opened as a whole publish the
+        * "SUBDATASETS" domain, which lists one subdataset per temporal slice.
+        *
         * @see GDALPamDataset::GetMetadata
         * @param pszDomain the domain of interest. Use "" or NULL for the default domain
         * @return char** NULL or a string list.
         */
-        // char ** GetMetadata ( const char * pszDomain = "");
+        char** GetMetadata(const char* pszDomain = "");
+
+        /**
+        * @brief Lists the available metadata domains including "SUBDATASETS" if applicable
+        *
+        * @see GDALMajorObject::GetMetadataDomainList
+        * @return char** a string list owned by the caller
+        */
+        char** GetMetadataDomainList();
+
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 1, 0)
+        /**
+        * @brief Returns the root group of the multidimensional API
+        *
+        * The group contains one multidimensional array per attribute, with a temporal dimension for
+        * spatio-temporal arrays, see scidb4gdal::SciDBMDGroup.
+        *
+        * @see GDALDataset::GetRootGroup
+        */
+        std::shared_ptr<GDALGroup> GetRootGroup() const;
+#endif
 
         /**
         * @brief Set single metadata item.
@@ -221,13 +333,26 @@ namespace scidb4gdal {
         * @param poSrcDS the source GDAL data set in which the data is stored
         * @param pfnProgress the progress function
         * @param pProgressData the progress data
+        * @param stats running statistics of all bands that are updated with every uploaded block, NODATA values are ignored, may be NULL
         * @return void
         */
         static void uploadImageIntoTempArray(ShimClient* client,
                                             SciDBSpatialArray& array,
                                             GDALDataset* poSrcDS,
                                             GDALProgressFunc pfnProgress,
-                                            void* pProgressData);
+                                            void* pProgressData,
+                                            vector<BandAccumulator>* stats = NULL);
+
+        /**
+        * @brief Stores statistics and histograms gathered while uploading an image as attribute metadata of an array
+        *
+        * The default histogram is derived from the value counts of 8 and 16 bit integer bands, with the buckets of
+        * GDALRasterBand::GetDefaultHistogram().
+        *
+        * @param stats statistics of all bands, see uploadImageIntoTempArray()
+        * @param array the array whose attribute metadata is extended
+        */
+        static void statisticsToMD(const vector<BandAccumulator>& stats, SciDBSpatialArray& array);
 
         /**
         * @brief Checks if an array can be inserted into another array
@@ -240,6 +365,169 @@ namespace scidb4gdal {
         * @return bool
         */
         static bool arrayIntegrateable(SciDBSpatialArray& src_array, SciDBSpatialArray& tar_array);
+
+        /**
+        * @brief Checks if an image can be appended to a spatiotemporal array without deriving coordinates on the server
+        *
+        * This is the case if the image has the timestamp, the attributes and the pixel grid of the target array, i.e. its pixels
+        * are shifted by whole cells only, and lies within the spatial dimensions of the target array.
+        *
+        * @param src_array the source array metadata representation
+        * @param tar_array the existing target array
+        * @param options the creation parameters containing the timestamp of the image
+        * @param dx [out] offset of the image in x direction of the target array
+        * @param dy [out] offset of the image in y direction of the target array
+        * @param t [out] temporal index of the image in the target array
+        * @return bool
+        */
+        static bool sliceAppendable(SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                    int64_t& dx, int64_t& dy, int64_t& t);
+
+        /**
+        * @brief Appends an image as temporal slice with coordinates computed on the client
+        *
+        * Tiles of the image are uploaded with their coordinates in the target array into a temporary array with the schema of the target
+        * array, which is then inserted into the target array with a single operation. The cost does not depend on the size of the target array.
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param src_array the source array metadata representation, including NODATA values
+        * @param tar_array the existing target array
+        * @param poSrcDS the source GDAL data set
+        * @param dx offset of the image in x direction of the target array, see sliceAppendable()
+        * @param dy offset of the image in y direction of the target array, see sliceAppendable()
+        * @param t temporal index of the image in the target array, see sliceAppendable()
+        * @param pfnProgress the progress function
+        * @param pProgressData the progress data
+        * @return scidb4gdal::StatusCode
+        */
+        static StatusCode appendSlice(ShimClient* client, SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array, GDALDataset* poSrcDS,
+                                      int64_t dx, int64_t dy, int64_t t, GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief Uploads an image with its coordinates in the target array into a temporary array with the schema of the target array
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param slice the temporary array, NODATA values of its attributes are replaced by those of the image
+        * @param src_array the source array metadata representation, including NODATA values
+        * @param poSrcDS the source GDAL data set
+        * @param dx offset of the image in x direction of the target array, see sliceAppendable()
+        * @param dy offset of the image in y direction of the target array, see sliceAppendable()
+        * @param t temporal index of the image in the target array, see sliceAppendable()
+        * @param pfnProgress the progress function
+        * @param pProgressData the progress data
+        * @return scidb4gdal::StatusCode, ERR_CREATE_TERMINATEDBYUSER if the progress function requested to stop
+        */
+        static StatusCode uploadImageIntoSlice(ShimClient* client, SciDBSpatioTemporalArray& slice, SciDBSpatialArray& src_array, GDALDataset* poSrcDS,
+                                               int64_t dx, int64_t dy, int64_t t, GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief Uploads the tiles of the current image of a reader into a temporary array with the schema of the target array
+        *
+        * Tiles are read by the background thread of the reader while the tiles read before are uploaded.
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param slice the temporary array, NODATA values of its attributes are replaced by those of the image
+        * @param src_array the source array metadata representation, including NODATA values
+        * @param reader the reader, its current image is the image to upload
+        * @param t temporal index of the image in the target array, see sliceAppendable()
+        * @param pfnProgress the progress function
+        * @param pProgressData the progress data
+        * @return scidb4gdal::StatusCode, ERR_CREATE_TERMINATEDBYUSER if the progress function requested to stop
+        */
+        static StatusCode uploadTilesIntoSlice(ShimClient* client, SciDBSpatioTemporalArray& slice, SciDBSpatialArray& src_array, TileReader& reader,
+                                               int64_t t, GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief An image of a SOURCES list, opened and checked ahead of its upload
+        */
+        struct SourceImage {
+            /** the opened image, NULL if it cannot be opened */
+            GDALDataset* poSrcDS;
+            /** the image metadata representation, including its temporal reference */
+            SciDBSpatioTemporalArray src;
+            /** SUCCESS if the image can be appended */
+            StatusCode res;
+            /** true if the image is on the grid of the target array and goes into the shared temporary array */
+            bool appendable;
+            /** offsets and temporal index of the image in the target array, see sliceAppendable() */
+            int64_t dx, dy, t;
+
+            SourceImage() : poSrcDS(NULL), res(SUCCESS), appendable(false), dx(0), dy(0), t(0) {}
+        };
+
+        /**
+        * @brief Opens an image of a SOURCES list and checks whether and how it can be appended to the target array
+        *
+        * @param file file name of the image
+        * @param timestamp timestamp of the image, see readSourceList()
+        * @param tar_array the existing target array
+        * @param options the creation parameters of the CreateCopy() call
+        * @param out [out] the opened image, must be closed by the caller
+        */
+        static void prepareSource(const string& file, const string& timestamp, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                  SourceImage& out);
+
+        /**
+        * @brief Reads the list of images given by the SOURCES creation option
+        *
+        * Every line holds a file name, optionally followed by a semicolon and the ISO 8601 timestamp of the image. Empty lines and lines
+        * starting with '#' are ignored.
+        *
+        * @param listfile name of the text file
+        * @param files [out] file names of the images
+        * @param timestamps [out] timestamps of the images, empty if the TIMESTAMP metadata item of the image shall be used
+        * @return false if the file cannot be read
+        */
+        static bool readSourceList(const string& listfile, vector<string>& files, vector<string>& timestamps);
+
+        /**
+        * @brief Appends a list of images to an existing ST_SERIES array
+        *
+        * All images use the same client. Images on the grid of the target array are uploaded with their target coordinates into one shared
+        * temporary array, which is inserted into the target array at the end, i.e. the whole list creates a single new array version. Their
+        * tiles are read and converted by a TileReader in the background, one image ahead, while the tiles read before are uploaded. Uploads
+        * stay sequential, as every insertion locks the shared temporary array. Other
+        * images are inserted one by one by means of insertInto(). Images that cannot be opened, have no timestamp or do not fit into the
+        * target array are skipped with a warning. If the upload of an image into the shared temporary array fails, the temporary array is
+        * removed and none of its images are inserted.
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param tar_array the existing target array
+        * @param options the creation parameters of the CreateCopy() call
+        * @param files file names of the images
+        * @param timestamps timestamps of the images, see readSourceList()
+        * @param pfnProgress the progress function of the CreateCopy() call
+        * @param pProgressData the progress data of the CreateCopy() call
+        * @return scidb4gdal::StatusCode
+        */
+        static StatusCode ingestSources(ShimClient* client, SciDBSpatioTemporalArray& tar_array, CreationParameters* options,
+                                        const vector<string>& files, const vector<string>& timestamps,
+                                        GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief Appends an uploaded image to an ST_SERIES array in batches
+        *
+        * The image is inserted into a temporary staging array with the schema and references of the target array instead of into the target
+        * array itself. Once the image completes a temporal chunk of the target array, or the FLUSH creation option is set, all staged images
+        * are inserted into the target array with a single operation, i.e. one new array version per temporal chunk. Staged images of a different
+        * temporal chunk are inserted before a new image is staged.
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param src_array the uploaded image, registered with its spatial and temporal reference
+        * @param tar_array the existing target array
+        * @param options the creation parameters containing the timestamp of the image
+        * @return scidb4gdal::StatusCode
+        */
+        static StatusCode stageImage(ShimClient* client, SciDBSpatialArray& src_array, SciDBSpatioTemporalArray& tar_array,
+                                     CreationParameters* options);
+
+        /**
+        * @brief Marks persisted statistics and default histograms of an array as outdated after data has been appended
+        *
+        * @param client the ShimClient holding the necessary information to connect to the web client
+        * @param array the modified array including its attribute metadata
+        */
+        static void clearStatistics(ShimClient* client, SciDBSpatialArray& array);
     };
 
     /**
@@ -247,9 +535,78 @@ namespace scidb4gdal {
     */
     class SciDBRasterBand : public GDALPamRasterBand {
         friend class SciDBDataset;
+        friend class SciDBMaskBand;
 
         SciDBSpatialArray* _array; //!< associated array metadata object
         char** papszMetadata;
+        int _attr; //!< index of the array attribute, starting with 0
+        int _t; //!< temporal index for bands of a temporal range, -1 otherwise
+        int _reduction; //!< index of the temporal reduction in SciDBDataset::_reductions, -1 otherwise
+        string _timeseries; //!< result of the last time series request, see GetMetadataItem()
+        SciDBHistogram _hist; //!< result of the last histogram request, see GetHistogram()
+
+        /**
+        * @brief Reads the default histogram from the attribute metadata
+        *
+        * @return true if the attribute has a persisted default histogram
+        */
+        bool loadDefaultHistogram(SciDBHistogram& out);
+
+        /**
+        * @brief Returns the temporal index of the band, i.e. of the data set if it represents a single slice, -1 otherwise
+        */
+        int64_t sliceIndex();
+
+        /**
+        * @brief Checks whether the band is masked by the mask of empty cells of the data set
+        *
+        * Bands with a no data value, of temporal ranges and of reductions use the default mask of GDAL instead, which
+        * also masks null values and empty cells as they are returned as no data.
+        */
+        bool hasDatasetMask();
+
+        /**
+        * @brief Computes the id of a block of a band in the tile cache
+        */
+        uint32_t getTileId(int nBlockXOff, int nBlockYOff, int band);
+
+        /**
+        * @brief Fetches a block of the band from SciDB
+        *
+        * Only non-empty cells are transferred, empty cells are filled with the no data value of the attribute.
+        *
+        * @param nBlockXOff the column offset as a number
+        * @param nBlockYOff the row offset as a number
+        * @param tile [out] the block, with memory allocated by this function
+        * @param mask [out] the mask of empty cells of the block, see SciDBMaskBand, with memory allocated by this function
+        * @return CPLErr
+        */
+        CPLErr fetchBlock(int nBlockXOff, int nBlockYOff, ArrayTile& tile, ArrayTile& mask);
+
+        /**
+        * @brief Reads a block of all bands of a temporal range with one query
+        *
+        * The block of the requested band is written to pImage, blocks of all other bands are added to the tile cache.
+        */
+        CPLErr readTemporalRangeBlock(int nBlockXOff, int nBlockYOff, void* pImage);
+
+        /**
+        * @brief Computes a block of all temporal reductions of the band's attribute with one query
+        *
+        * The block of the requested band is written to pImage, blocks of the other reductions are added to the tile cache.
+        */
+        CPLErr readTemporalReductionBlock(int nBlockXOff, int nBlockYOff, void* pImage);
+
+        /**
+        * @brief Reads a block of a temporal slice from the read-ahead buffer
+        *
+        * If the block has not been buffered but the same window has been read from the previous slice before, the following slices
+        * up to the end of the temporal chunk are fetched with one query and buffered. If the band is masked by the mask of empty cells,
+        * the mask is buffered along with the slices and the mask tile of the block is added to the tile cache.
+        *
+        * @return true if the block has been written to pImage
+        */
+        bool readSliceAhead(int nBlockXOff, int nBlockYOff, void* pImage);
 
     public:
         /**
@@ -257,9 +614,11 @@ namespace scidb4gdal {
         *
         * @param poDS the parent dataset
         * @param array the metadata representation of the array
-        * @param nBand the number of the band in the data set
+        * @param nBand the index of the array attribute, starting with 0
+        * @param tIndex temporal index of the band if the data set represents a temporal range, -1 otherwise
+        * @param reduction index of the temporal reduction of the band, -1 otherwise
         */
-        SciDBRasterBand(SciDBDataset* poDS, SciDBSpatialArray* array, int nBand);
+        SciDBRasterBand(SciDBDataset* poDS, SciDBSpatialArray* array, int nBand, int tIndex = -1, int reduction = -1);
 
         /**
         * @brief Band destructor
@@ -286,11 +645,78 @@ namespace scidb4gdal {
         // virtual CPLErr IWriteBlock ( int nBlockXOff, int nBlockYOff, void *pImage
         // );
 
-        /** @copydoc GDALRasterBand::GetStatistics */
+        /**
+        * @brief Fetch image statistics
+        *
+        * Statistics of all bands are computed at once by one aggregate query, cached by the data set and persisted as attribute
+        * metadata. Bands of temporal slices get the statistics of their slice only, which are cached by temporal index but not
+        * persisted. Without bForce, only cached or persisted statistics are returned. With bApproxOK, statistics are computed from a
+        * bernoulli sample of the cells and flagged by the STATISTICS_APPROXIMATE metadata item; exact statistics are used if known.
+        *
+        * @see GDALRasterBand::GetStatistics
+        */
         virtual CPLErr GetStatistics(int bApproxOK, int bForce, double* pdfMin,
                                     double* pdfMax, double* pdfMean,
                                     double* pdfStdDev);
 
+        /**
+        * @brief Computes a histogram in SciDB
+        *
+        * Only the counts per bucket are transferred. The last histogram is cached by the band. With bApproxOK, the histogram is computed
+        * from a bernoulli sample of the cells, see GetStatistics().
+        *
+        * @see GDALRasterBand::GetHistogram
+        */
+        virtual CPLErr GetHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram, int bIncludeOutOfRange,
+                                    int bApproxOK, GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief Fetch the default histogram
+        *
+        * The default histogram is read from the attribute metadata. If there is none and bForce is set, it is computed in SciDB with the
+        * buckets GDAL would use and stored as attribute metadata.
+        *
+        * @see GDALRasterBand::GetDefaultHistogram
+        */
+        virtual CPLErr GetDefaultHistogram(double* pdfMin, double* pdfMax, int* pnBuckets, GUIntBig** ppanHistogram, int bForce,
+                                           GDALProgressFunc pfnProgress, void* pProgressData);
+
+        /**
+        * @brief Stores the default histogram as attribute metadata
+        *
+        * @see GDALRasterBand::SetDefaultHistogram
+        */
+        virtual CPLErr SetDefaultHistogram(double dfMin, double dfMax, int nBuckets, GUIntBig* panHistogram);
+
+        /**
+        * @brief Fetch single metadata item, including pixel time series
+        *
+        * The "TIMESERIES" domain extracts complete time series of the band's attribute at a batch of locations with
+        * a single query. The item name is a blank separated list of locations, each given as "Pixel_<x>_<y>" in pixel
+        * coordinates or as "GeoPixel_<x>_<y>" in georeferenced coordinates. The result has one line per location with
+        * comma separated values. The time steps are listed by the item "TIMESTAMPS" of the same domain. Data sets of a
+        * temporal range return the time steps of the range, all other data sets those of the whole array.
+        *
+        * @see GDALPamRasterBand::GetMetadataItem
+        * @param pszName the key for the metadata item to fetch.
+        * @param pszDomain the domain to fetch for, use NULL for the default domain.
+        * @return const char* NULL or the value of the item
+        */
+        virtual const char* GetMetadataItem(const char* pszName, const char* pszDomain = "");
+
+        /**
+        * @brief Empty cells of the array are masked for all bands of a data set without no data value
+        *
+        * Bands with a no data value, of temporal ranges and of reductions have the default mask of GDAL, see
+        * hasDatasetMask().
+        *
+        * @see GDALRasterBand::GetMaskFlags
+        */
+        virtual int GetMaskFlags();
+
+        /** @copydoc GDALRasterBand::GetMaskBand */
+        virtual GDALRasterBand* GetMaskBand();
+
         /** @copydoc GDALPamRasterBand::GetNoDataValue */
         virtual double GetNoDataValue(int* pbSuccess = NULL);
 
@@ -309,6 +735,35 @@ namespace scidb4gdal {
         /** @copydoc GDALPamRasterBand::GetUnitType */
         virtual const char* GetUnitType();
     };
+
+    /**
+    * @brief Mask band of the empty cells of a SciDB array
+    *
+    * Cells are valid (255) if they are non-empty in SciDB and invalid (0) otherwise. Null values are specific to an attribute and
+    * replaced with the NODATA value of the band instead. The mask is shared by all bands of a data set (GMF_PER_DATASET). It is derived while fetching blocks of attribute bands, which only transfer non-empty cells, and is kept in the
+    * tile cache of the data set.
+    */
+    class SciDBMaskBand : public GDALRasterBand {
+    public:
+        /**
+        * @brief Creates the mask band of a data set
+        *
+        * @param poDS the parent dataset, must have at least one band
+        */
+        SciDBMaskBand(SciDBDataset* poDS);
+
+        /**
+        * @brief Reads the mask of a block from the tile cache, or fetches the block of the first band
+        *
+        * @see GDALRasterBand::IReadBlock
+        */
+        virtual CPLErr IReadBlock(int nBlockXOff, int nBlockYOff, void* pImage);
+
+        /**
+        * @brief Computes the id of the mask of a block in the tile cache of the data set
+        */
+        static uint32_t getTileId(GDALDataset* poDS, int nBlockXOff, int nBlockYOff, int nBlockXSize, int nBlockYSize);
+    };
 }
 
 #endif
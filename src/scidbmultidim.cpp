@@ -0,0 +1,248 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#include "tilecache.h"
+
+#include "scidbmultidim.h"
+
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 1, 0)
+
+#include "ogr_spatialref.h"
+
+namespace scidb4gdal {
+
+    /* =============================================
+    *  SciDBMDGroup
+    * =============================================
+    */
+    SciDBMDGroup::SciDBMDGroup(const shared_ptr<SciDBMDContext>& ctx)
+        : GDALGroup(string(), "/"), _ctx(ctx) {}
+
+    shared_ptr<GDALGroup> SciDBMDGroup::Create(const boost::shared_ptr<ShimClient>& client, SciDBSpatialArray& array) {
+        shared_ptr<SciDBMDContext> ctx(new SciDBMDContext(client, array));
+        shared_ptr<SciDBMDGroup> group(new SciDBMDGroup(ctx));
+        SciDBSpatialArray* arr = ctx->array;
+
+        // Dimensions in (t,)y,x order, such that x varies fastest as in GDAL's classic raster API
+        SciDBDimension* xdim = arr->getXDim();
+        SciDBDimension* ydim = arr->getYDim();
+        shared_ptr<GDALDimensionWeakIndexingVar> x(new GDALDimensionWeakIndexingVar(
+            "/", xdim->name, GDAL_DIM_TYPE_HORIZONTAL_X, "", xdim->high - xdim->low + 1));
+        shared_ptr<GDALDimensionWeakIndexingVar> y(new GDALDimensionWeakIndexingVar(
+            "/", ydim->name, GDAL_DIM_TYPE_HORIZONTAL_Y, "", ydim->high - ydim->low + 1));
+
+        SciDBSpatioTemporalArray* starr = dynamic_cast<SciDBSpatioTemporalArray*>(arr);
+        if (starr) {
+            SciDBDimension* tdim = starr->getTDim();
+            shared_ptr<GDALDimensionWeakIndexingVar> t(new GDALDimensionWeakIndexingVar(
+                "/", tdim->name, GDAL_DIM_TYPE_TEMPORAL, "", tdim->high - tdim->low + 1));
+            shared_ptr<GDALMDArray> tvar(new SciDBMDIndexingVariable(ctx, SciDBMDIndexingVariable::INDEX_T, t));
+            t->SetIndexingVariable(tvar);
+            group->_dims.push_back(t);
+            group->_arrays.push_back(tvar);
+        }
+        group->_dims.push_back(y);
+        group->_dims.push_back(x);
+
+        // Coordinate variables can only be given for transformations without rotation
+        if (arr->affineTransform._a12 == 0 && arr->affineTransform._a21 == 0) {
+            shared_ptr<GDALMDArray> yvar(new SciDBMDIndexingVariable(ctx, SciDBMDIndexingVariable::INDEX_Y, y));
+            shared_ptr<GDALMDArray> xvar(new SciDBMDIndexingVariable(ctx, SciDBMDIndexingVariable::INDEX_X, x));
+            y->SetIndexingVariable(yvar);
+            x->SetIndexingVariable(xvar);
+            group->_arrays.push_back(yvar);
+            group->_arrays.push_back(xvar);
+        }
+
+        for (size_t i = 0; i < arr->attrs.size(); ++i) {
+            if (arr->attrs[i].type.gdalType == GDT_Unknown) {
+                Utils::debug("Attribute '" + arr->attrs[i].name + "' has no corresponding GDAL data type and is skipped");
+                continue;
+            }
+            group->_arrays.push_back(shared_ptr<GDALMDArray>(new SciDBMDArray(ctx, (uint8_t) i, group->_dims)));
+        }
+        return group;
+    }
+
+    vector<string> SciDBMDGroup::GetMDArrayNames(CSLConstList) const {
+        vector<string> names;
+        for (size_t i = 0; i < _arrays.size(); ++i) names.push_back(_arrays[i]->GetName());
+        return names;
+    }
+
+    shared_ptr<GDALMDArray> SciDBMDGroup::OpenMDArray(const string& osName, CSLConstList) const {
+        for (size_t i = 0; i < _arrays.size(); ++i) {
+            if (_arrays[i]->GetName() == osName) return _arrays[i];
+        }
+        return nullptr;
+    }
+
+    vector<shared_ptr<GDALDimension> > SciDBMDGroup::GetDimensions(CSLConstList) const {
+        return _dims;
+    }
+
+    /* =============================================
+    *  SciDBMDArray
+    * =============================================
+    */
+    SciDBMDArray::SciDBMDArray(const shared_ptr<SciDBMDContext>& ctx, uint8_t nband,
+                               const vector<shared_ptr<GDALDimension> >& dims)
+        : GDALAbstractMDArray("/", ctx->array->attrs[nband].name),
+          GDALMDArray("/", ctx->array->attrs[nband].name),
+          _ctx(ctx), _nband(nband), _dims(dims),
+          _dt(GDALExtendedDataType::Create(ctx->array->attrs[nband].type.gdalType)) {
+        SciDBAttribute& attr = _ctx->array->attrs[nband];
+        _nodata.resize(attr.type.bytes);
+        Utils::fillValue(&_nodata[0], 1, attr.type, CPLAtof(attr.noData().c_str()));
+    }
+
+    const void* SciDBMDArray::GetRawNoDataValue() const {
+        return _nodata.empty() ? nullptr : &_nodata[0];
+    }
+
+    shared_ptr<OGRSpatialReference> SciDBMDArray::GetSpatialRef() const {
+        if (_ctx->array->srtext.empty()) return nullptr;
+        shared_ptr<OGRSpatialReference> srs(new OGRSpatialReference());
+        if (srs->importFromWkt(_ctx->array->srtext.c_str()) != OGRERR_NONE) return nullptr;
+        srs->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        // x and y are always the two last dimensions
+        vector<int> mapping;
+        mapping.push_back((int) _dims.size());
+        mapping.push_back((int) _dims.size() - 1);
+        srs->SetDataAxisToSRSAxisMapping(mapping);
+        return srs;
+    }
+
+    bool SciDBMDArray::IRead(const GUInt64* arrayStartIdx, const size_t* count, const GInt64* arrayStep,
+                             const GPtrDiff_t* bufferStride, const GDALExtendedDataType& bufferDataType,
+                             void* pDstBuffer) const {
+        const size_t ndims = _dims.size();
+
+        // Bounding box of all requested cells, steps may be negative
+        vector<GUInt64> lo(ndims), hull(ndims);
+        for (size_t d = 0; d < ndims; ++d) {
+            GUInt64 last = arrayStartIdx[d] + (count[d] - 1) * arrayStep[d];
+            lo[d] = std::min(arrayStartIdx[d], last);
+            hull[d] = std::max(arrayStartIdx[d], last) - lo[d] + 1;
+        }
+
+        // Dimension indexes are relative to the lower bounds of the SciDB dimensions
+        SciDBSpatialArray& arr = *_ctx->array;
+        const size_t dx = ndims - 1, dy = ndims - 2;
+        int64_t xmin = arr.getXDim()->low + lo[dx], xmax = xmin + hull[dx] - 1;
+        int64_t ymin = arr.getYDim()->low + lo[dy], ymax = ymin + hull[dy] - 1;
+        int64_t tmin = 0, tmax = 0;
+        SciDBSpatioTemporalArray* starr = dynamic_cast<SciDBSpatioTemporalArray*>(&arr);
+        if (starr) {
+            tmin = starr->getTDim()->low + lo[0];
+            tmax = tmin + hull[0] - 1;
+        }
+
+        size_t n = 1;
+        for (size_t d = 0; d < ndims; ++d) n *= hull[d];
+        const size_t bytes = _dt.GetSize();
+        vector<GByte> slab;
+        try {
+            slab.resize(n * bytes);
+        } catch (const std::bad_alloc&) {
+            CPLError(CE_Failure, CPLE_OutOfMemory, "Cannot allocate memory for hyperslab of array '%s'", arr.name.c_str());
+            return false;
+        }
+        {
+            CPLMutexHolderD(&_ctx->hMutex);
+            if (_ctx->client->getHyperslab(arr, _nband, &slab[0], xmin, ymin, xmax, ymax, tmin, tmax) != SUCCESS)
+                return false;
+        }
+
+        // Strides of the bounding box in cells
+        vector<size_t> hullStride(ndims);
+        hullStride[ndims - 1] = 1;
+        for (size_t d = ndims - 1; d > 0; --d) hullStride[d - 1] = hullStride[d] * hull[d];
+
+        const size_t dstBytes = bufferDataType.GetSize();
+        GByte* dst = (GByte*) pDstBuffer;
+        vector<size_t> idx(ndims, 0);
+        while (true) {
+            size_t src = 0;
+            GPtrDiff_t dstOff = 0;
+            for (size_t d = 0; d < ndims; ++d) {
+                src += (size_t) (arrayStartIdx[d] + idx[d] * arrayStep[d] - lo[d]) * hullStride[d];
+                dstOff += (GPtrDiff_t) idx[d] * bufferStride[d];
+            }
+            GDALExtendedDataType::CopyValue(&slab[src * bytes], _dt, dst + dstOff * (GPtrDiff_t) dstBytes, bufferDataType);
+
+            size_t d = ndims;
+            while (d > 0 && ++idx[d - 1] == count[d - 1]) {
+                idx[d - 1] = 0;
+                --d;
+            }
+            if (d == 0) break;
+        }
+        return true;
+    }
+
+    /* =============================================
+    *  SciDBMDIndexingVariable
+    * =============================================
+    */
+    SciDBMDIndexingVariable::SciDBMDIndexingVariable(const shared_ptr<SciDBMDContext>& ctx, Kind kind,
+                                                     const shared_ptr<GDALDimension>& dim)
+        : GDALAbstractMDArray("/", dim->GetName()),
+          GDALMDArray("/", dim->GetName()),
+          _ctx(ctx), _kind(kind), _dims(1, dim),
+          _dt(kind == INDEX_T ? GDALExtendedDataType::CreateString() : GDALExtendedDataType::Create(GDT_Float64)) {}
+
+    bool SciDBMDIndexingVariable::IRead(const GUInt64* arrayStartIdx, const size_t* count, const GInt64* arrayStep,
+                                        const GPtrDiff_t* bufferStride, const GDALExtendedDataType& bufferDataType,
+                                        void* pDstBuffer) const {
+        SciDBSpatialArray& arr = *_ctx->array;
+        SciDBSpatioTemporalArray* starr = dynamic_cast<SciDBSpatioTemporalArray*>(&arr);
+        if (_kind == INDEX_T && !starr) return false;
+
+        const size_t dstBytes = bufferDataType.GetSize();
+        GByte* dst = (GByte*) pDstBuffer;
+        for (size_t i = 0; i < count[0]; ++i) {
+            int64_t k = (int64_t) (arrayStartIdx[0] + i * arrayStep[0]);
+            GByte* out = dst + (GPtrDiff_t) i * bufferStride[0] * (GPtrDiff_t) dstBytes;
+            if (_kind == INDEX_T) {
+                TPoint time = starr->datetimeAtIndex((int) (starr->getTDim()->low + k));
+                time._resolution = starr->getTInterval()->_resolution;
+                string s = time.toStringISO();
+                const char* psz = s.c_str();
+                GDALExtendedDataType::CopyValue(&psz, _dt, out, bufferDataType);
+            } else {
+                // cell centers
+                AffineTransform::double2 p(arr.getXDim()->low + 0.5, arr.getYDim()->low + 0.5);
+                if (_kind == INDEX_X) p.x += k;
+                else p.y += k;
+                arr.affineTransform.f(p);
+                double v = (_kind == INDEX_X) ? p.x : p.y;
+                GDALExtendedDataType::CopyValue(&v, _dt, out, bufferDataType);
+            }
+        }
+        return true;
+    }
+}
+
+#endif
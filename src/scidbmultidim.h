@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#include "tilecache.h"
+
+#ifndef SCIDBMULTIDIM_H
+#define SCIDBMULTIDIM_H
+
+#include "gdal_priv.h"
+
+// The multidimensional API is available since GDAL 3.1
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3, 1, 0)
+
+#include <memory>
+#include <boost/shared_ptr.hpp>
+#include "shimclient.h"
+#include "scidb_structs.h"
+
+namespace scidb4gdal {
+    using namespace std;
+
+    /**
+    * @brief Connection and array descriptor shared by the objects of the multidimensional API
+    *
+    * Groups and arrays may outlive the data set they were obtained from. They hence share ownership of the SHIM client
+    * with the data set and use their own copy of the array descriptor.
+    */
+    struct SciDBMDContext {
+        /**
+        * @brief Shares the client and copies the array descriptor of a data set
+        */
+        SciDBMDContext(const boost::shared_ptr<ShimClient>& c, SciDBSpatialArray& a) : client(c), array(a.clone()), hMutex(NULL) {}
+        ~SciDBMDContext() {
+            delete array;
+            if (hMutex != NULL) CPLDestroyMutex(hMutex);
+        }
+
+        /** client of the data set used for all requests, not thread-safe on its own */
+        boost::shared_ptr<ShimClient> client;
+        /** array descriptor */
+        SciDBSpatialArray* array;
+        /** serializes requests of the client */
+        CPLMutex* hMutex;
+    };
+
+    /**
+    * @brief Root group of a SciDB array, containing one multidimensional array per attribute
+    *
+    * Attribute arrays have dimensions (t,y,x) for spatio-temporal arrays and (y,x) for spatial arrays. Dimensions are
+    * indexed from the lower bound of the corresponding SciDB dimension. The temporal dimension is accompanied by an
+    * indexing variable with ISO 8601 date/time strings, x and y by indexing variables with cell center coordinates
+    * if the affine transformation is not rotated.
+    */
+    class SciDBMDGroup : public GDALGroup {
+    public:
+        /**
+        * @brief Creates the root group of a data set
+        * @param client SHIM client of the data set, will be shared
+        * @param array array descriptor of the data set, will be copied
+        */
+        static shared_ptr<GDALGroup> Create(const boost::shared_ptr<ShimClient>& client, SciDBSpatialArray& array);
+
+        vector<string> GetMDArrayNames(CSLConstList papszOptions = nullptr) const override;
+        shared_ptr<GDALMDArray> OpenMDArray(const string& osName, CSLConstList papszOptions = nullptr) const override;
+        vector<shared_ptr<GDALDimension> > GetDimensions(CSLConstList papszOptions = nullptr) const override;
+
+    protected:
+        /** @brief Basic constructor, see Create() */
+        SciDBMDGroup(const shared_ptr<SciDBMDContext>& ctx);
+
+        /** shared client and array descriptor */
+        shared_ptr<SciDBMDContext> _ctx;
+        /** dimensions (t,)y,x */
+        vector<shared_ptr<GDALDimension> > _dims;
+        /** attribute arrays and indexing variables */
+        vector<shared_ptr<GDALMDArray> > _arrays;
+    };
+
+    /**
+    * @brief One attribute of a SciDB array as multidimensional array
+    *
+    * Reads of arbitrary hyperslabs are translated to a single query for the bounding box of the requested cells,
+    * see ShimClient::getHyperslab().
+    */
+    class SciDBMDArray : public GDALMDArray {
+    public:
+        /**
+        * @brief Basic constructor
+        * @param ctx shared client and array descriptor
+        * @param nband attribute index
+        * @param dims dimensions in (t,)y,x order
+        */
+        SciDBMDArray(const shared_ptr<SciDBMDContext>& ctx, uint8_t nband, const vector<shared_ptr<GDALDimension> >& dims);
+
+        bool IsWritable() const override { return false; }
+        const string& GetFilename() const { return _ctx->array->name; }
+        const vector<shared_ptr<GDALDimension> >& GetDimensions() const override { return _dims; }
+        const GDALExtendedDataType& GetDataType() const override { return _dt; }
+        const void* GetRawNoDataValue() const override;
+        shared_ptr<OGRSpatialReference> GetSpatialRef() const override;
+
+    protected:
+        bool IRead(const GUInt64* arrayStartIdx, const size_t* count, const GInt64* arrayStep,
+                   const GPtrDiff_t* bufferStride, const GDALExtendedDataType& bufferDataType,
+                   void* pDstBuffer) const override;
+
+    private:
+        /** shared client and array descriptor */
+        shared_ptr<SciDBMDContext> _ctx;
+        /** attribute index */
+        uint8_t _nband;
+        /** dimensions (t,)y,x */
+        vector<shared_ptr<GDALDimension> > _dims;
+        /** data type of the attribute */
+        GDALExtendedDataType _dt;
+        /** raw no data value in the attribute data type */
+        vector<GByte> _nodata;
+    };
+
+    /**
+    * @brief Indexing variable of a spatial or temporal dimension, computed from the array's reference systems
+    */
+    class SciDBMDIndexingVariable : public GDALMDArray {
+    public:
+        /** kind of dimension the variable belongs to */
+        enum Kind { INDEX_X, INDEX_Y, INDEX_T };
+
+        /**
+        * @brief Basic constructor
+        * @param ctx shared client and array descriptor
+        * @param kind kind of the dimension
+        * @param dim the dimension
+        */
+        SciDBMDIndexingVariable(const shared_ptr<SciDBMDContext>& ctx, Kind kind, const shared_ptr<GDALDimension>& dim);
+
+        bool IsWritable() const override { return false; }
+        const string& GetFilename() const { return _ctx->array->name; }
+        const vector<shared_ptr<GDALDimension> >& GetDimensions() const override { return _dims; }
+        const GDALExtendedDataType& GetDataType() const override { return _dt; }
+
+    protected:
+        bool IRead(const GUInt64* arrayStartIdx, const size_t* count, const GInt64* arrayStep,
+                   const GPtrDiff_t* bufferStride, const GDALExtendedDataType& bufferDataType,
+                   void* pDstBuffer) const override;
+
+    private:
+        /** shared client and array descriptor */
+        shared_ptr<SciDBMDContext> _ctx;
+        /** kind of dimension */
+        Kind _kind;
+        /** the single dimension */
+        vector<shared_ptr<GDALDimension> > _dims;
+        /** Float64 for spatial, String for temporal variables */
+        GDALExtendedDataType _dt;
+    };
+}
+
+#endif
+#endif
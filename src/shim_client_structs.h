@@ -54,7 +54,15 @@ namespace scidb4gdal {
         BBOX,
         SRS,
         CHUNKSIZE_SPATIAL,
-        CHUNKSIZE_TEMPORAL
+        CHUNKSIZE_TEMPORAL,
+        REDUCE,
+        BATCH,
+        FLUSH,
+        SOURCES,
+        STATS_SAMPLE,
+        HISTOGRAM,
+        DENSE_THRESHOLD,
+        READ_STRATEGY
     };
 
     /**
@@ -105,6 +113,14 @@ namespace scidb4gdal {
         int chunksize_spatial;
         /** the blocksize for the temporal dimension */
         int chunksize_temporal;
+        /** whether or not images appended to an existing ST_SERIES array are staged until a temporal chunk is complete */
+        bool batch;
+        /** whether or not staged images are inserted into the target array regardless of the temporal chunk */
+        bool flush;
+        /** text file listing further images that are appended to the ST_SERIES array after the source image */
+        string sources;
+        /** whether or not default histograms of 8 and 16 bit integer bands are computed while uploading */
+        bool histogram;
 
         CreationParameters() { _init(); }
 
@@ -117,6 +133,10 @@ namespace scidb4gdal {
             type = S_ARRAY;
             chunksize_spatial = -1;
             chunksize_temporal = -1;
+            batch = false;
+            flush = false;
+            sources = "";
+            histogram = false;
             timestamp = "";
             dt = "";
             hasBBOX = false;
@@ -142,6 +162,18 @@ namespace scidb4gdal {
         }
     };
 
+    /**
+    * @brief Operator that cuts blocks out of an array, see ShimClient::getData()
+    */
+    enum ReadStrategy {
+        /** chosen per block from the alignment with chunk boundaries and from measured latencies */
+        READ_AUTO,
+        /** subarray(), moves the block to coordinates starting at 0 */
+        READ_SUBARRAY,
+        /** between(), keeps coordinates and chunks of the array, fast for blocks that coincide with a chunk */
+        READ_BETWEEN
+    };
+
     /**
     * @brief Structure to store information of a query to retrieve data from the user input
     *
@@ -156,18 +188,32 @@ namespace scidb4gdal {
     struct QueryParameters : Parameters {
         /** the temporal index of an temporally referenced array */
         int temp_index;
-        /** the lower bound of an interval query (currently not implemented) */
+        /** the lower temporal index of an interval query */
         int lower_bound;
-        /** the upper bound of an interval query (currently not implemented) */
+        /** the upper temporal index of an interval query */
         int upper_bound;
         /** the dimension name pf the temporal axis */
         string dim_name;
-        /** the ISO 8601 data/time string to query for */
+        /** the ISO 8601 data/time string to query for, or the start of an interval query */
         string timestamp;
+        /** the ISO 8601 data/time string of the end of an interval query */
+        string timestamp_end;
         /** flag whether or not the temporal index was set */
         bool hasTemporalIndex;
+        /** flag whether or not a temporal interval was requested, either by lower_bound and upper_bound or by timestamp and timestamp_end */
+        bool hasTemporalRange;
+        /** temporal reductions (mean, min, max, count) that are computed in SciDB and exposed as bands */
+        vector<string> reductions;
+        /** fraction of cells sampled for approximate statistics */
+        double stats_sample;
+        /** minimum density of the previous block for fetching a block as values only instead of (value, position) records */
+        double dense_threshold;
+        /** operator that cuts blocks out of the array */
+        ReadStrategy read_strategy;
 
-        QueryParameters() : temp_index(-1), hasTemporalIndex(false) {}
+        QueryParameters() : temp_index(-1), lower_bound(-1), upper_bound(-1), hasTemporalIndex(false), hasTemporalRange(false),
+                            stats_sample(SCIDB4GDAL_DEFAULT_STATS_SAMPLE), dense_threshold(SCIDB4GDAL_DEFAULT_DENSE_THRESHOLD),
+                            read_strategy(READ_AUTO) {}
     };
 
     /**
@@ -233,6 +279,92 @@ namespace scidb4gdal {
         };
     };
 
+    /**
+    * @brief Measured latencies of block reads with subarray() and between()
+    */
+    struct ReadLatency {
+        /** moving average of the latency per cell in seconds, indexed by ReadStrategy */
+        double secondsPerCell[3];
+        /** number of measured blocks, indexed by ReadStrategy */
+        uint32_t samples[3];
+
+        ReadLatency() {
+            for (int i = 0; i < 3; ++i) {
+                secondsPerCell[i] = 0;
+                samples[i] = 0;
+            }
+        }
+    };
+
+    /**
+    * @brief Placeholders of prepared AFL query templates
+    *
+    * Identifies the values that are inserted into a prepared data query when it is executed.
+    */
+    enum AFLQueryParameter {
+        /** left boundary of the requested block */
+        AFL_PARAM_XMIN,
+        /** lower boundary of the requested block */
+        AFL_PARAM_YMIN,
+        /** right boundary of the requested block */
+        AFL_PARAM_XMAX,
+        /** upper boundary of the requested block */
+        AFL_PARAM_YMAX,
+        /** xmax - xmin */
+        AFL_PARAM_XEXTENT,
+        /** ymax - ymin */
+        AFL_PARAM_YEXTENT
+    };
+
+    /**
+    * @brief A prepared, already URL-escaped query for fetching blocks of a single band
+    *
+    * The query string is stored as literal segments with placeholders in between, i.e. segments.size() == params.size() + 1.
+    * Executing the query only requires formatting the block boundaries.
+    */
+    struct AFLQueryTemplate {
+        /** URL-escaped literal parts of the query */
+        vector<string> segments;
+        /** placeholders between the segments */
+        vector<AFLQueryParameter> params;
+    };
+
+    /**
+    * @brief Identifies a prepared data query template
+    */
+    struct AFLQueryTemplateKey {
+        /** array name or slice expression the data is read from, including the temporal index */
+        string arr;
+        /** name of the attribute */
+        string attr;
+        /** SciDB type of the attribute, determines the save format */
+        string typeId;
+        /** nullability of the attribute, determines the save format */
+        bool nullable;
+        /** name of the x dimension */
+        string xdim;
+        /** name of the y dimension */
+        string ydim;
+        /** whether x precedes y in the dimensions of the array, determines the order of block boundaries */
+        bool xfirst;
+        /** whether subarray() or between() is used */
+        bool use_subarray;
+        /** whether only non-empty cells are fetched together with their position */
+        bool sparse;
+
+        bool operator<(const AFLQueryTemplateKey& o) const {
+            if (arr != o.arr) return arr < o.arr;
+            if (attr != o.attr) return attr < o.attr;
+            if (typeId != o.typeId) return typeId < o.typeId;
+            if (nullable != o.nullable) return nullable < o.nullable;
+            if (xdim != o.xdim) return xdim < o.xdim;
+            if (ydim != o.ydim) return ydim < o.ydim;
+            if (xfirst != o.xfirst) return xfirst < o.xfirst;
+            if (use_subarray != o.use_subarray) return use_subarray < o.use_subarray;
+            return sparse < o.sparse;
+        }
+    };
+
     /**
     * @brief Helper structure filled while fetching scidb binary stream
     *
@@ -35,7 +35,7 @@ namespace scidb4gdal {
     using namespace scidb4geo;
 
     ShimClient::ShimClient()
-    : _host("https://localhost"), _port(8083), _user("scidb"), _passwd("scidb"), _ssl(true), _curl_handle(0), _curl_initialized(false), _auth(""), _hasSCIDB4GEO(NULL), _shimversion("") {
+    : _host("https://localhost"), _port(8083), _user("scidb"), _passwd("scidb"), _ssl(true), _curl_handle(0), _curl_initialized(false), _auth(""), _conp(NULL), _cp(NULL), _qp(NULL), _hasSCIDB4GEO(NULL), _shimversion(""), _hReadMutex(NULL) {
         curl_global_init(CURL_GLOBAL_ALL);
         stringstream ss;
 
@@ -57,7 +57,7 @@ namespace scidb4gdal {
 
     ShimClient::ShimClient(string host, uint16_t port, string user, string passwd,
                            bool ssl = false)
-    : _host(host), _port(port), _user(user), _passwd(passwd), _ssl(ssl), _curl_handle(0), _curl_initialized(false), _auth(""), _hasSCIDB4GEO(NULL), _shimversion("") {
+    : _host(host), _port(port), _user(user), _passwd(passwd), _ssl(ssl), _curl_handle(0), _curl_initialized(false), _auth(""), _conp(NULL), _cp(NULL), _qp(NULL), _hasSCIDB4GEO(NULL), _shimversion(""), _hReadMutex(NULL) {
         curl_global_init(CURL_GLOBAL_ALL);
         stringstream ss;
 
@@ -88,8 +88,12 @@ namespace scidb4gdal {
     _curl_handle(0),
     _curl_initialized(false),
     _auth(""),
+    _conp(NULL),
+    _cp(NULL),
+    _qp(NULL),
     _hasSCIDB4GEO(NULL),
-    _shimversion("") {
+    _shimversion(""),
+    _hReadMutex(NULL) {
 
         curl_global_init(CURL_GLOBAL_ALL);
 
@@ -111,12 +115,35 @@ namespace scidb4gdal {
         _host = ss.str();
     }
 
+    ShimClient::ShimClient(const ShimClient& other) :
+    _host(other._host),
+    _port(other._port),
+    _user(other._user),
+    _passwd(other._passwd),
+    _ssl(other._ssl),
+    _ssltrust(other._ssltrust),
+    _curl_handle(0),
+    _curl_initialized(false),
+    _auth(""),
+    _conp(other._conp != NULL ? new ConnectionParameters(*other._conp) : NULL),
+    _cp(other._cp != NULL ? new CreationParameters(*other._cp) : NULL),
+    _qp(other._qp != NULL ? new QueryParameters(*other._qp) : NULL),
+    _hasSCIDB4GEO(other._hasSCIDB4GEO != NULL ? new bool(*other._hasSCIDB4GEO) : NULL),
+    _shimversion(other._shimversion),
+    _hReadMutex(NULL) {
+        curl_global_init(CURL_GLOBAL_ALL);
+    }
+
     ShimClient::~ShimClient() {
         if (_ssl && !_auth.empty())
             logout();
         curl_global_cleanup();
         _curl_handle = 0;
         if (_hasSCIDB4GEO != NULL) delete _hasSCIDB4GEO;
+        delete _conp;
+        delete _cp;
+        delete _qp;
+        if (_hReadMutex != NULL) CPLDestroyMutex(_hReadMutex);
     }
 
     /**
@@ -205,6 +232,20 @@ namespace scidb4gdal {
         return res;
     }
 
+    bool ShimClient::curlPerformSucceeded() {
+        CURLcode res = curlPerform();
+        long http_code = 0;
+        curl_easy_getinfo(_curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+        return res == CURLE_OK && http_code == 200;
+    }
+
+    string ShimClient::saveParameter(const string& format) {
+        char* escaped = curl_easy_escape(_curl_handle, format.c_str(), 0);
+        string out = "&save=" + string(escaped);
+        curl_free(escaped);
+        return out;
+    }
+
     StatusCode ShimClient::testConnection() {
         curlBegin();
 
@@ -305,13 +346,13 @@ namespace scidb4gdal {
         afl << "aggregate(filter(list('libraries'), name='libscidb4geo.so'), count(name))";
         Utils::debug("Performing AFL Query: " + afl.str());
 
+        curlBegin();
         ss.str();
-        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?" << "id=" << sessionID << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0) << "&save=" << "(uint64)";
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?" << "id=" << sessionID << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0) << saveParameter("(uint64)");
         // Add auth parameter if using ssl
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
 
-        curlBegin();
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
         if (curlPerform() != CURLE_OK) {
@@ -516,8 +557,8 @@ namespace scidb4gdal {
             Utils::debug("Performing AFL Query: " + afl.str());
             ss << _host << SHIMENDPOINT_EXECUTEQUERY;
             ss << "?"
-                    << "id=" << sessionID << "&query=" << afl.str() << "&save="
-                    << "csv";
+                    << "id=" << sessionID << "&query=" << afl.str()
+                    << saveParameter("(string,string,bool)");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -570,20 +611,19 @@ namespace scidb4gdal {
         ss.str("");
 
 
-        CSVstring* csv;
-        if (!isVersionGreaterThan(15, 7)) {
-            csv = new CSVstring(response, true); // with header
-        } else csv = new CSVstring(response, false); // with header
-
-
-        for (int i = 0; i < csv->nrow(); ++i) {
+        BinaryReader bin(response);
+        while (!bin.eof()) {
             SciDBAttribute attr;
-            attr.name = csv->get<string>(i, 0).substr(1, csv->get<string>(i, 0).length() - 2); // remove ''
-            attr.typeId = csv->get<string>(i, 1).substr(1, csv->get<string>(i, 1).length() - 2); // remove ''
-            attr.nullable = ((csv->get<string>(i, 2).compare("TRUE") * csv->get<string>(i, 2).compare("true")) == 0);
+            string typeId;
+            if (!(bin.readString(attr.name) && bin.readString(typeId) && bin.readBool(attr.nullable))) {
+                Utils::error("Cannot parse attribute information of array '" + inArrayName + "'.");
+                releaseSession(sessionID);
+                return ERR_GLOBAL_PARSE;
+            }
+            attr.setType(typeId);
 
             // Assert attr has datatype that is supported by GDAL
-            if (Utils::scidbTypeIdToGDALType(attr.typeId) == GDT_Unknown) {
+            if (attr.type.gdalType == GDT_Unknown) {
                 ss.str("");
                 ss << "SciDB GDAL driver does not support data type " << attr.typeId << ". Array attribute '" << attr.name << "' will be ignored.";
                 Utils::warn(ss.str());
@@ -592,8 +632,6 @@ namespace scidb4gdal {
             out.push_back(attr);
         }
 
-        delete csv;
-
         releaseSession(sessionID);
 
         if (out.size() == 0) {
@@ -620,12 +658,13 @@ namespace scidb4gdal {
             stringstream ss;
             stringstream afl;
             // project(dimensions(chicago2),name,low,high,type)
-            afl << "project(dimensions(" << inArrayName << "),name,low,high,type,chunk_interval,start,length)";
+            // Numeric columns are casted explicitly because their types differ between SciDB versions
+            afl << "project(apply(dimensions(" << inArrayName << "),low_i64,int64(low),high_i64,int64(high),chunk_i64,int64(chunk_interval),start_i64,int64(start),length_i64,int64(length)),name,low_i64,high_i64,type,chunk_i64,start_i64,length_i64)";
             Utils::debug("Performing AFL Query: " + afl.str());
 
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                    << "id=" << sessionID << "&query=" << afl.str() << "&save="
-                    << "csv";
+                    << "id=" << sessionID << "&query=" << afl.str()
+                    << saveParameter("(string,int64,int64,string,int64,int64,int64)");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -671,41 +710,30 @@ namespace scidb4gdal {
             curlEnd();
         }
 
-        // Parse CSV
-
-
-
-
-
-        CSVstring* csv;
-        if (!isVersionGreaterThan(15, 7)) {
-            csv = new CSVstring(response, true); // with header
-        } else csv = new CSVstring(response, false); // with header
-
-
-        for (int i = 0; i < csv->nrow(); ++i) {
+        // Parse binary response
+        BinaryReader bin(response);
+        while (!bin.eof()) {
             SciDBDimension dim;
-            dim.name = csv->get<string>(i, 0).substr(1, csv->get<string>(i, 0).length() - 2);
-            dim.low = boost::lexical_cast<int64_t>(csv->get<string>(i, 1).c_str());
-            dim.high = boost::lexical_cast<int64_t>(csv->get<string>(i, 2).c_str());
-            // Remove quotes
-            dim.typeId = csv->get<string>(i, 3).substr(1, csv->get<string>(i, 3).length() - 2);
-            dim.chunksize = boost::lexical_cast<uint32_t>(csv->get<string>(i, 4).c_str());
-            dim.start = boost::lexical_cast<int64_t>(csv->get<string>(i, 5).c_str());
-            dim.length = boost::lexical_cast<int64_t>(csv->get<string>(i, 6).c_str());
+            int64_t chunksize, length;
+            if (!(bin.readString(dim.name) && bin.readInt64(dim.low) && bin.readInt64(dim.high) &&
+                  bin.readString(dim.typeId) && bin.readInt64(chunksize) && bin.readInt64(dim.start) &&
+                  bin.readInt64(length))) {
+                Utils::error("Cannot parse dimension information of array '" + inArrayName + "'.");
+                releaseSession(sessionID);
+                return ERR_GLOBAL_PARSE;
+            }
+            dim.chunksize = (uint32_t) chunksize;
+            dim.length = (uint64_t) length;
 
             // yet unspecified e.g. for newly created arrays
             if (dim.high == SCIDB_MAX_DIM_INDEX || dim.low == SCIDB_MAX_DIM_INDEX ||
                 dim.high == -SCIDB_MAX_DIM_INDEX || dim.low == -SCIDB_MAX_DIM_INDEX) {
-                dim.low = boost::lexical_cast<int64_t>(csv->get<string>(i, 5).c_str());
-                dim.high = dim.low + boost::lexical_cast<int64_t>(csv->get<string>(i, 6).c_str()) - 1;
+                dim.low = dim.start;
+                dim.high = dim.low + length - 1;
             }
 
             // Assert  dim.typeId is integer
-            if (!(dim.typeId == "int32" || dim.typeId == "int64" ||
-                  dim.typeId == "int16" || dim.typeId == "int8" ||
-                  dim.typeId == "uint32" || dim.typeId == "uint64" ||
-                  dim.typeId == "uint16" || dim.typeId == "uint8")) {
+            if (!Utils::scidbTypeDesc(dim.typeId).isInteger) {
                 stringstream ss;
                 ss << "SciDB GDAL driver works with integer dimensions only. Got dimension " << dim.name << ":" << dim.typeId;
                 Utils::error(ss.str());
@@ -716,10 +744,6 @@ namespace scidb4gdal {
 
         }
 
-
-
-        delete csv;
-
         releaseSession(sessionID);
 
         return SUCCESS;
@@ -746,11 +770,11 @@ namespace scidb4gdal {
             stringstream ss;
             stringstream afl;
             // project(dimensions(chicago2),name,low,high,type)
-            afl << "project(apply(st_getsrs(" << inArrayName << "),auth_srid_str,string(auth_srid)),name,xdim,ydim,srtext,proj4text,A,auth_name,auth_srid_str)"; // Everything should be a string to smiplify CSV col separation
+            afl << "project(apply(st_getsrs(" << inArrayName << "),auth_srid_i64,int64(auth_srid)),xdim,ydim,srtext,proj4text,A,auth_name,auth_srid_i64)";
             Utils::debug("Performing AFL Query: " + afl.str());
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                    << "id=" << sessionID << "&query=" << afl.str() << "&save="
-                    << "csv";
+                    << "id=" << sessionID << "&query=" << afl.str()
+                    << saveParameter("(string null,string null,string null,string null,string null,string null,int64 null)");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -801,40 +825,30 @@ namespace scidb4gdal {
             curlEnd();
         }
 
-        // Parse CSV
-
-        CSVstring* csv;
-        if (!isVersionGreaterThan(15, 7)) {
-            csv = new CSVstring(response, "','", "\n", true); // with header
-        } else csv = new CSVstring(response, "','", "\n", false); // without header
-
-
-
-        if (csv->nrow() != 1 || csv->ncol() != 8) {
-            delete csv;
-            Utils::error("Cannot extract spatial reference of array '" + inArrayName + "'.");
-            return ERR_GLOBAL_PARSE;
+        // Parse binary response, all attributes of st_getsrs are nullable
+        BinaryReader bin(response);
+        string fields[6];
+        bool isnull;
+        for (int i = 0; i < 6; ++i) {
+            if (!(bin.readNullFlag(isnull) && bin.readString(fields[i]))) break;
+            if (isnull) fields[i] = "";
         }
+        int64_t srid = 0;
+        if (bin.readNullFlag(isnull) && bin.readInt64(srid) && isnull) srid = 0;
 
-
-
-        try {
-
-            out.xdim = csv->get<string>(0, 1);
-            out.ydim = csv->get<string>(0, 2);
-            out.srtext = csv->get<string>(0, 3);
-            out.proj4text = csv->get<string>(0, 4);
-            out.affineTransform = *(new AffineTransform(csv->get<string>(0, 5)));
-            out.auth_name = csv->get<string>(0, 6);
-            out.auth_srid = boost::lexical_cast<uint32_t>(csv->get<string>(0, 7).substr(0, csv->get<string>(0, 7).length() - 1)); // last colum has ' ending
-        } catch (const boost::bad_lexical_cast &) {
-            delete csv;
-            Utils::warn("Cannot extract spatial reference of array '" + inArrayName + "'.");
+        if (bin.fail() || !bin.eof()) {
+            Utils::error("Cannot extract spatial reference of array '" + inArrayName + "'.");
+            releaseSession(sessionID);
             return ERR_GLOBAL_PARSE;
         }
 
-
-        delete csv;
+        out.xdim = fields[0];
+        out.ydim = fields[1];
+        out.srtext = fields[2];
+        out.proj4text = fields[3];
+        out.affineTransform = AffineTransform(fields[4]);
+        out.auth_name = fields[5];
+        out.auth_srid = (uint32_t) srid;
 
         releaseSession(sessionID);
 
@@ -854,8 +868,8 @@ namespace scidb4gdal {
             afl << "project(st_gettrs(" << inArrayName << "),tdim,t0,dt)";
             Utils::debug("Performing AFL Query: " + afl.str());
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                    << "id=" << sessionID << "&query=" << afl.str() << "&save="
-                    << "csv";
+                    << "id=" << sessionID << "&query=" << afl.str()
+                    << saveParameter("csv");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -906,7 +920,7 @@ namespace scidb4gdal {
         CSVstring* csv;
         if (!isVersionGreaterThan(15, 7)) {
             csv = new CSVstring(response, true); // with header
-        } else csv = new CSVstring(response, false); // with header
+        } else csv = new CSVstring(response, false); // without header
 
 
         if (csv->nrow() != 1 || csv->ncol() != 3) {
@@ -917,9 +931,9 @@ namespace scidb4gdal {
 
 
 
-        out.tdim = csv->get<string>(0, 0).substr(1, csv->get<string>(0, 0).length() - 2); // remove ''
-        TPoint* p = new TPoint(csv->get<string>(0, 1).substr(1, csv->get<string>(0, 1).length() - 2)); // remove '';
-        TInterval* i = new TInterval(csv->get<string>(0, 2).substr(1, csv->get<string>(0, 2).length() - 2)); // remove '';
+        out.tdim = csv->get<string>(0, 0);
+        TPoint* p = new TPoint(csv->get<string>(0, 1));
+        TInterval* i = new TInterval(csv->get<string>(0, 2));
         out.setTPoint(p);
         out.setTInterval(i);
 
@@ -1014,7 +1028,7 @@ namespace scidb4gdal {
             afl << "project(filter(eo_arrays(), name='" << name << "'),name,setting)";
             Utils::debug("Performing AFL Query: " + afl.str());
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                    << "id=" << sessionID << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0) << "&save=" << "csv";
+                    << "id=" << sessionID << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0) << saveParameter("csv");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -1073,9 +1087,9 @@ namespace scidb4gdal {
         }
 
 
-        if (csv->get<string>(0, 1).compare("'s'") == 0) {
+        if (csv->equals(0, 1, "s")) {
             array = new SciDBSpatialArray();
-        } else if (csv->get<string>(0, 1).compare("'st'") == 0) {
+        } else if (csv->equals(0, 1, "st")) {
             array = new SciDBSpatioTemporalArray();
         } else {
             Utils::error("Cannot derive setting for array '" + name + "'. Invalid response of project(filter(eo_arrays(...))).");
@@ -1089,9 +1103,9 @@ namespace scidb4gdal {
 
     StatusCode ShimClient::getData(SciDBSpatialArray& array, uint8_t nband,
                                    void* outchunk, int32_t x_min, int32_t y_min,
-                                   int32_t x_max, int32_t y_max, bool use_subarray,
-                                   bool emptycheck) {
-        int t_index;
+                                   int32_t x_max, int32_t y_max, ReadStrategy strategy,
+                                   bool emptycheck, uint8_t* mask) {
+        int t_index = -1;
         if (x_min < array.getXDim()->low || x_min > array.getXDim()->high ||
             x_max < array.getXDim()->low || x_max > array.getXDim()->high ||
             y_min < array.getYDim()->low || y_min > array.getYDim()->high ||
@@ -1099,36 +1113,10 @@ namespace scidb4gdal {
             Utils::error("Requested array subset is outside array boundaries");
         }
 
-        if (nband >= array.attrs.size())
+        if (nband >= array.attrs.size()) {
             Utils::error("Requested array band does not exist");
-
-        int8_t x_idx = array.getXDimIdx();
-        int8_t y_idx = array.getYDimIdx();
-
-        stringstream ss;
-        string response;
-
-
-
-        MD md = array.attrs[nband].md[""];
-        string naval;
-        if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA) == md.end()) {
-            stringstream dtos;
-            dtos << Utils::defaultNoDataSciDB(array.attrs[nband].typeId);
-            naval = dtos.str();
-        } else naval = md[SCIDB4GDAL_DEFAULTMDFIELD_NODATA];
-
-
-
-
-        int sessionID = newSession();
-
-        /* Depending on dimension ordering, array must be transposed. */
-
-        curlBegin();
-        // EXECUTE QUERY  ////////////////////////////
-        ss.str();
-        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?" << "id=" << sessionID;
+            return ERR_READ_UNKNOWN;
+        }
 
         stringstream tslice;
         if (SciDBSpatioTemporalArray * starray =
@@ -1152,120 +1140,136 @@ namespace scidb4gdal {
             tslice << array.name;
         }
 
-        string arr = tslice.str();
-
-        stringstream afl;
-        if (x_idx > y_idx) { // TODO: need to check performance of differend ordering
-
-            if (use_subarray) {
-                if (emptycheck) {
-                    afl << "(merge(";
-                    afl << "project(subarray(" << arr << "," << y_min << "," << x_min << ","
-                            << y_max << "," << x_max << ")," << array.attrs[nband].name << ")";
-                    afl << ",build(<" << array.attrs[nband].name << ":"
-                            << array.attrs[nband].typeId << ((array.attrs[nband].nullable) ? " NULL" : " NOT NULL")
-                            << "> [" << array.getYDim()->name
-                            << "=" << 0 << ":" << y_max - y_min << ","
-                            << array.getYDim()->chunksize << "," << 0 << ","
-                            << array.getXDim()->name << "=" << 0 << ":" << x_max - x_min << ","
-                            << array.getXDim()->chunksize << "," << 0 << "],"
-                            << naval << ")))";
-                } else {
-                    afl << "(project(subarray(" << arr << "," << y_min << "," << x_min
-                            << "," << y_max << "," << x_max << ")," << array.attrs[nband].name
-                            << "))";
-                }
-            } else { // Between
-                // TODO: Test which way is the fastest
-                if (emptycheck) {
-                    afl << "(merge(";
-                    afl << "project(between(" << arr << "," << y_min << "," << x_min << ","
-                            << y_max << "," << x_max << ")," << array.attrs[nband].name << ")";
-                    afl << ",between(build(<" << array.attrs[nband].name << ":"
-                            << array.attrs[nband].typeId << ((array.attrs[nband].nullable) ? " NULL" : " NOT NULL")
-                            << "> [" << array.getYDim()->name
-                            << "=" << array.getYDim()->start << ":"
-                            << array.getYDim()->start + array.getYDim()->length - 1 << ","
-                            << array.getYDim()->chunksize << "," << 0 << ","
-                            << array.getXDim()->name << "=" << array.getXDim()->start << ":"
-                            << array.getXDim()->start + array.getXDim()->length - 1 << ","
-                            << array.getXDim()->chunksize << "," << 0 << "]," << naval << "),"
-                            << y_min << "," << x_min << "," << y_max << "," << x_max << ")))";
-                } else {
-                    afl << "(project(between(" << arr << "," << y_min << "," << x_min << ","
-                            << y_max << "," << x_max << ")," << array.attrs[nband].name << "))";
-                }
-            }
-        } else {
-            if (use_subarray) {
-                if (emptycheck) {
-                    afl << "transpose(merge(";
-                    afl << "project(subarray(" << arr << "," << x_min << "," << y_min << ","
-                            << x_max << "," << y_max << ")," << array.attrs[nband].name << ")";
-                    afl << ",build(<" << array.attrs[nband].name << ":"
-                            << array.attrs[nband].typeId << ((array.attrs[nband].nullable) ? " NULL" : " NOT NULL")
-                            << "> [" << array.getXDim()->name
-                            << "=" << 0 << ":" << x_max - x_min << ","
-                            << array.getXDim()->chunksize << "," << 0 << ","
-                            << array.getYDim()->name << "=" << 0 << ":" << y_max - y_min << ","
-                            << array.getYDim()->chunksize << "," << 0 << "],"
-                            << naval << ")))";
-                } else {
-                    afl << "transpose(project(subarray(" << arr << "," << x_min << ","
-                            << y_min << "," << x_max << "," << y_max << "),"
-                            << array.attrs[nband].name << "))";
-                }
-            } else {
-                if (emptycheck) {
-                    afl << "transpose(merge(";
-                    afl << "project(between(" << arr << "," << x_min << "," << y_min << ","
-                            << x_max << "," << y_max << ")," << array.attrs[nband].name << ")";
-                    afl << ",between(build(<" << array.attrs[nband].name << ":"
-                            << array.attrs[nband].typeId << ((array.attrs[nband].nullable) ? " NULL" : " NOT NULL")
-                            << "> [" << array.getXDim()->name
-                            << "=" << array.getXDim()->start << ":"
-                            << array.getXDim()->start + array.getXDim()->length - 1 << ","
-                            << array.getXDim()->chunksize << "," << 0 << ","
-                            << array.getYDim()->name << "=" << array.getYDim()->start << ":"
-                            << array.getYDim()->start + array.getYDim()->length - 1 << ","
-                            << array.getYDim()->chunksize << "," << 0 << "]," << naval << "),"
-                            << x_min << "," << y_min << "," << x_max << "," << y_max << ")))";
-                } else {
-                    afl << "transpose(project(between(" << arr << "," << x_min << ","
-                            << y_min << "," << x_max << "," << y_max << "),"
-                            << array.attrs[nband].name << "))";
-                }
+        if (strategy == READ_AUTO && _qp) strategy = _qp->read_strategy;
+        const size_t n = (size_t) (x_max - x_min + 1) * (size_t) (y_max - y_min + 1);
+        size_t count = 0;
+        if (!emptycheck) {
+            StatusCode res = readBlock(array, nband, tslice.str(), outchunk, x_min, y_min, x_max, y_max, strategy, false, mask, count);
+            if (res == SUCCESS && count != n) {
+                Utils::error("Block of array '" + array.name + "' contains empty cells, it cannot be read without empty check");
+                return ERR_READ_UNKNOWN;
             }
+            return res;
         }
 
-        //  If attribute is nullable, apply substitute to fill null cells with default null value
-        if (array.attrs[nband].nullable) {
-            string afl_temp = afl.str();
-            afl.str("");
-            afl << "substitute(" << afl_temp << ", build(<val:" << array.attrs[nband].typeId << ">[i=0:0, 1, 0], " << naval << "))";
-
+        /* Values only (dense) are a fraction of the size of (value, position) records (sparse) but can only be placed if the block has no
+         * empty cells. The dense format is tried if the density of the previous block of the array reaches the threshold, otherwise or if
+         * the block turns out to have empty cells, the sparse format is used. Both formats tell the density of the block. */
+        double density;
+        {
+            CPLMutexHolderD(&_hReadMutex);
+            density = _blockDensity.insert(std::pair<string, double>(tslice.str(), 0)).first->second;
+        }
+        const double threshold = _qp ? _qp->dense_threshold : SCIDB4GDAL_DEFAULT_DENSE_THRESHOLD;
+        if (density >= threshold) {
+            StatusCode res = readBlock(array, nband, tslice.str(), outchunk, x_min, y_min, x_max, y_max, strategy, false, mask, count);
+            if (res != SUCCESS) return res;
+            {
+                CPLMutexHolderD(&_hReadMutex);
+                _blockDensity[tslice.str()] = (double) count / (double) n;
+            }
+            if (count == n) return SUCCESS;
+            Utils::debug("Block has empty cells, reading non-empty cells only");
+        }
+        StatusCode res = readBlock(array, nband, tslice.str(), outchunk, x_min, y_min, x_max, y_max, strategy, true, mask, count);
+        if (res == SUCCESS) {
+            CPLMutexHolderD(&_hReadMutex);
+            _blockDensity[tslice.str()] = (double) count / (double) n;
         }
+        return res;
+    }
 
+    StatusCode ShimClient::readBlock(SciDBSpatialArray& array, uint8_t nband, const string& arr, void* outchunk,
+                                     int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max, ReadStrategy strategy, bool sparse,
+                                     uint8_t* mask, size_t& ncells) {
+        stringstream ss;
+        string response;
+        ncells = 0;
 
+        // Blocks that coincide with a chunk are cut out by between() without moving cells to new coordinates, see useSubarray()
+        SciDBDimension* xdim = array.getXDim();
+        SciDBDimension* ydim = array.getYDim();
+        const bool aligned = (x_min - xdim->start) % xdim->chunksize == 0 && (y_min - ydim->start) % ydim->chunksize == 0 &&
+                             x_max - x_min < (int64_t) xdim->chunksize && y_max - y_min < (int64_t) ydim->chunksize;
+        const bool use_subarray = useSubarray(arr, strategy, aligned, sparse);
 
-        Utils::debug("Performing AFL Query: " + afl.str());
+        int sessionID = newSession();
 
+        curlBegin();
 
-        ss << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0)
-                << "&save=" << "(" << array.attrs[nband].typeId;
-        //if (array.attrs[nband].nullable) ss  << " " <<  "null";
-        ss << ")";
-        // Add auth parameter if using ssl
+        // Find or prepare the query template, only block boundaries change between calls
+        AFLQueryTemplateKey key;
+        key.arr = arr;
+        key.attr = array.attrs[nband].name;
+        key.typeId = array.attrs[nband].typeId;
+        key.nullable = array.attrs[nband].nullable;
+        key.xdim = xdim->name;
+        key.ydim = ydim->name;
+        key.xfirst = array.getXDimIdx() < array.getYDimIdx();
+        key.use_subarray = use_subarray;
+        key.sparse = sparse;
+        const AFLQueryTemplate* qt; // entries are never removed, the map keeps them in place
+        {
+            CPLMutexHolderD(&_hReadMutex);
+            map<AFLQueryTemplateKey, AFLQueryTemplate>::iterator it = _dataQueryTemplates.find(key);
+            if (it == _dataQueryTemplates.end()) {
+                it = _dataQueryTemplates.insert(std::pair<AFLQueryTemplateKey, AFLQueryTemplate>(
+                        key, prepareDataQuery(array, nband, arr, use_subarray, sparse))).first;
+            }
+            qt = &it->second;
+        }
+
+        // EXECUTE QUERY  ////////////////////////////
+        string url;
+        url.reserve(256);
+        url.append(_host).append(SHIMENDPOINT_EXECUTEQUERY).append("?id=");
+        char num[24];
+        sprintf(num, "%d", sessionID);
+        url.append(num);
+        for (size_t i = 0; i < qt->params.size(); ++i) {
+            url.append(qt->segments[i]);
+            int32_t v = 0;
+            switch (qt->params[i]) {
+                case AFL_PARAM_XMIN: v = x_min;
+                    break;
+                case AFL_PARAM_YMIN: v = y_min;
+                    break;
+                case AFL_PARAM_XMAX: v = x_max;
+                    break;
+                case AFL_PARAM_YMAX: v = y_max;
+                    break;
+                case AFL_PARAM_XEXTENT: v = x_max - x_min;
+                    break;
+                case AFL_PARAM_YEXTENT: v = y_max - y_min;
+                    break;
+            }
+            sprintf(num, "%d", v);
+            url.append(num);
+        }
+        url.append(qt->segments.back());
+        // Add auth parameter if using ssl, the session may have been renewed since the template has been prepared
         if (_ssl && !_auth.empty())
-            ss << "&auth=" << _auth;
+            url.append("&auth=").append(_auth);
 
-        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, url.c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
         response = "";
         curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION,
                          &responseToStringCallback);
         curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
-        curlPerform();
+        // Failed queries must not be taken for blocks without any non-empty cell
+        CURLcode res = curlPerform();
+        long http_code = 0;
+        curl_easy_getinfo(_curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+        if (res != CURLE_OK || http_code != 200) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot read block of array '" + array.name + "': " + response);
+            return ERR_READ_UNKNOWN;
+        }
+        double seconds = 0, t = 0;
+        curl_easy_getinfo(_curl_handle, CURLINFO_TOTAL_TIME, &t);
+        seconds += t;
         curlEnd();
 
         curlBegin();
@@ -1279,149 +1283,834 @@ namespace scidb4gdal {
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
 
+        SciDBAttribute& attr = array.attrs[nband];
+        const size_t nx = (size_t) (x_max - x_min + 1);
+        const size_t ny = (size_t) (y_max - y_min + 1);
+        const size_t n = nx * ny;
+        // Values arrive in the order of array dimensions, blocks of arrays with x preceding y are transposed client-side
+        const bool transposed = array.getXDimIdx() < array.getYDimIdx();
+        // Dense blocks without null values in the order of GDAL are written to the output directly
+        const bool direct = !sparse && !attr.nullable && !transposed;
+
         response = "";
         struct SingleAttributeChunk data;
         data.memory = (char*) outchunk;
         data.size = 0;
-
-        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, responseBinaryCallback);
-        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, (void*) &data);
-        curlPerform();
+        if (direct) {
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, responseBinaryCallback);
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, (void*) &data);
+        } else {
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        }
+        res = curlPerform();
+        curl_easy_getinfo(_curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+        if (res != CURLE_OK || http_code != 200) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot read block of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curl_easy_getinfo(_curl_handle, CURLINFO_TOTAL_TIME, &t);
+        seconds += t;
         curlEnd();
 
         releaseSession(sessionID);
 
-        outchunk = (void*) data.memory;
-
-        return SUCCESS;
-    }
-
-    StatusCode ShimClient::createTempArray(SciDBSpatialArray& array) {
-        if (array.name == "") {
-            Utils::error("Cannot create unnamed arrays");
-            return ERR_CREATE_INVALIDARRAYNAME;
-        }
-        bool exists;
-        arrayExists(array.name, exists);
-        if (exists) {
-            if (!(_cp->type == ST_SERIES || _cp->type == ST_ARRAY ||
-                  _cp->type == S_ARRAY)) {
-                Utils::error("Array '" + array.name +
-                             "' already exists in SciDB database");
-                return ERR_CREATE_ARRAYEXISTS;
+        recordLatency(arr, aligned, use_subarray, seconds / (double) n);
+        ss.str("");
+        ss << "Read block (" << x_min << "," << y_min << ")-(" << x_max << "," << y_max << ") of '" << arr << "' with "
+                << (use_subarray ? "subarray" : "between") << "(), " << (sparse ? "sparse" : "dense") << ", in " << seconds << " s";
+        Utils::debug(ss.str());
+
+        if (sparse) {
+            // Fill with no data values and scatter the (value, position) records of non-empty cells, null values keep the no data value
+            const size_t recordSize = (attr.nullable ? 1 : 0) + attr.type.bytes + sizeof (int64_t);
+            if (response.size() % recordSize != 0) {
+                Utils::error("Unexpected response size while reading data of array '" + array.name + "'");
+                return ERR_READ_UNKNOWN;
             }
+            ncells = response.size() / recordSize;
+            Utils::fillValue(outchunk, n, attr.type, CPLAtof(attr.noData().c_str()));
+            if (mask) memset(mask, 0, n);
+            Utils::scatterCells(attr.type.bytes, attr.nullable, (uint8_t*) outchunk, mask, n, (const uint8_t*) response.data(), ncells);
+            return SUCCESS;
         }
 
-        if (array.attrs.size() == 0) {
-            Utils::error("No array attributes specified");
-            return ERR_CREATE_UNKNOWN;
+        if (direct) {
+            ncells = data.size / attr.type.bytes;
+            if (mask) memset(mask, 255, n);
+            return SUCCESS;
         }
 
-        stringstream ss;
-
-        int sessionID = newSession();
+        ncells = response.size() / ((attr.nullable ? 1 : 0) + attr.type.bytes);
+        if (ncells != n) return SUCCESS; // the block has empty cells, values cannot be placed
 
-        // Build afl query, e.g. CREATE ARRAY A <x: double, err: double> [i=0:99,10,0,
-        // j=0:99,10,0];
-        stringstream afl;
-        afl << "CREATE TEMP ARRAY " << array.name << SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+        // All cells of the block are non-empty, null values do not affect the mask
+        if (mask) memset(mask, 255, n);
+        const uint8_t* values = (const uint8_t*) response.data();
+        vector<uint8_t> buf;
+        if (attr.nullable) {
+            // Each value is preceded by a missing reason byte, replace nulls with the no data value
+            uint8_t nodata[16];
+            Utils::fillValue(nodata, 1, attr.type, CPLAtof(attr.noData().c_str()));
+            if (transposed) buf.resize(n * attr.type.bytes);
+            uint8_t* dest = transposed ? &buf[0] : (uint8_t*) outchunk;
+            Utils::replaceNulls(attr.type.bytes, dest, values, n, nodata);
+            values = dest;
+        }
+        if (transposed) Utils::transpose(attr.type.bytes, outchunk, values, nx, ny);
+        return SUCCESS;
+    }
 
-        afl << array.getSchemaString();
+    bool ShimClient::useSubarray(const string& arr, ReadStrategy strategy, bool aligned, bool sparse) {
+        // Dense values of between() come in the order of the chunks of the array, which is the order of the block only if it is a single chunk
+        if (!aligned && !sparse) return true;
+        if (strategy == READ_SUBARRAY) return true;
+        if (strategy == READ_BETWEEN) return false;
+
+        CPLMutexHolderD(&_hReadMutex);
+        map<pair<string, bool>, ReadLatency>::iterator it = _readLatency.find(std::make_pair(arr, aligned));
+        if (it == _readLatency.end()) return !aligned;
+        ReadLatency& l = it->second;
+        // Measure both operators first, starting with the one expected to be faster, and try the slower one again from time to time
+        const int preferred = aligned ? READ_BETWEEN : READ_SUBARRAY;
+        const int other = aligned ? READ_SUBARRAY : READ_BETWEEN;
+        if (l.samples[preferred] < SCIDB4GDAL_READ_STRATEGY_PROBES) return preferred == READ_SUBARRAY;
+        if (l.samples[other] < SCIDB4GDAL_READ_STRATEGY_PROBES) return other == READ_SUBARRAY;
+        const int faster = (l.secondsPerCell[READ_SUBARRAY] <= l.secondsPerCell[READ_BETWEEN]) ? READ_SUBARRAY : READ_BETWEEN;
+        const int slower = (faster == READ_SUBARRAY) ? READ_BETWEEN : READ_SUBARRAY;
+        if ((l.samples[READ_SUBARRAY] + l.samples[READ_BETWEEN]) % SCIDB4GDAL_READ_STRATEGY_REPROBE == 0) return slower == READ_SUBARRAY;
+        return faster == READ_SUBARRAY;
+    }
 
+    void ShimClient::recordLatency(const string& arr, bool aligned, bool use_subarray, double secondsPerCell) {
+        CPLMutexHolderD(&_hReadMutex);
+        ReadLatency& l = _readLatency[std::make_pair(arr, aligned)];
+        const int s = use_subarray ? READ_SUBARRAY : READ_BETWEEN;
+        // exponentially weighted moving average, recent blocks count more as server load changes
+        l.secondsPerCell[s] = (l.samples[s] == 0) ? secondsPerCell : 0.75 * l.secondsPerCell[s] + 0.25 * secondsPerCell;
+        ++l.samples[s];
+    }
 
-        // Append attribute specification
-        //         afl << " <";
-        //         for (uint32_t i = 0; i < array.attrs.size(); ++i) {
-        //             afl << array.attrs[i].name << ": " << array.attrs[i].typeId;
-        //             if (i != array.attrs.size() - 1) {
-        //                 afl << ",";
-        //             } else {
-        //                 afl << ">";
-        //             }
-        //         }
-        //
-        //         // Append dimension spec
-        //         afl << " [";
-        //         for (uint32_t i = 0; i < array.dims.size(); ++i) {
-        //             string dimHigh = "";
-        //             if (array.dims[i].high == SCIDB_MAX_DIM_INDEX) {
-        //                 dimHigh = "*";
-        //             } else {
-        //                 dimHigh = boost::lexical_cast<string>(array.dims[i].high);
-        //             }
-        //
-        //             // TODO: Overlap
-        //             afl << array.dims[i].name << "=" << array.dims[i].low << ":" << dimHigh
-        //                 << "," << array.dims[i].chunksize << "," << 0;
-        //             if (i != array.dims.size() - 1) {
-        //                 afl << ", ";
-        //             } else {
-        //                 afl << "]";
-        //             }
-        //         }
+    StatusCode ShimClient::getHyperslab(SciDBSpatialArray& array, uint8_t nband, void* out,
+                                        int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max,
+                                        int64_t t_min, int64_t t_max, uint8_t* mask) {
+        vector<uint8_t> bands(1, nband);
+        vector<void*> outs(1, out);
+        return getHyperslab(array, bands, outs, x_min, y_min, x_max, y_max, t_min, t_max, mask);
+    }
 
+    StatusCode ShimClient::getHyperslab(SciDBSpatialArray& array, const vector<uint8_t>& bands, const vector<void*>& out,
+                                        int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max,
+                                        int64_t t_min, int64_t t_max, uint8_t* mask) {
+        if (bands.empty() || bands.size() != out.size()) {
+            Utils::error("Invalid band selection for hyperslab");
+            return ERR_READ_UNKNOWN;
+        }
+        for (size_t i = 0; i < bands.size(); ++i) {
+            if (bands[i] >= array.attrs.size()) {
+                Utils::error("Requested array band does not exist");
+                return ERR_READ_UNKNOWN;
+            }
+        }
+        SciDBDimension* xdim = array.getXDim();
+        SciDBDimension* ydim = array.getYDim();
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*> (&array);
+        SciDBDimension* tdim = starray ? starray->getTDim() : NULL;
+        if (!tdim) {
+            t_min = 0;
+            t_max = 0;
+        }
 
-        string aflquery = afl.str();
+        if (x_min > x_max || y_min > y_max || t_min > t_max ||
+            x_min < xdim->low || x_max > xdim->high ||
+            y_min < ydim->low || y_max > ydim->high ||
+            (tdim && (t_min < tdim->low || t_max > tdim->high))) {
+            Utils::error("Requested array subset is outside array boundaries");
+            return ERR_READ_BBOX;
+        }
+
+        const int64_t nx = x_max - x_min + 1;
+        const int64_t ny = y_max - y_min + 1;
+        const size_t n = (size_t) (nx * ny * (t_max - t_min + 1));
+
+        // between() expects boundaries in the order of array dimensions
+        vector<int64_t> lo(array.dims.size()), hi(array.dims.size());
+        for (size_t i = 0; i < array.dims.size(); ++i) {
+            lo[i] = array.dims[i].low;
+            hi[i] = array.dims[i].high;
+        }
+        lo[array.getXDimIdx()] = x_min;
+        hi[array.getXDimIdx()] = x_max;
+        lo[array.getYDimIdx()] = y_min;
+        hi[array.getYDimIdx()] = y_max;
+        if (tdim) {
+            lo[starray->getTDimIdx()] = t_min;
+            hi[starray->getTDimIdx()] = t_max;
+        }
+
+        stringstream afl, save;
+        afl << "project(between(" << array.name;
+        for (size_t i = 0; i < lo.size(); ++i) afl << "," << lo[i];
+        for (size_t i = 0; i < hi.size(); ++i) afl << "," << hi[i];
+        afl << ")";
+        for (size_t i = 0; i < bands.size(); ++i) afl << "," << array.attrs[bands[i]].name;
+        afl << ")";
+        save << "(";
+        size_t recordSize = 0;
+        for (size_t i = 0; i < bands.size(); ++i) {
+            SciDBAttribute& attr = array.attrs[bands[i]];
+            string naval = attr.noData();
+            Utils::fillValue(out[i], n, attr.type, CPLAtof(naval.c_str()));
+            // null values are preceded by a missing reason byte and keep the no data value
+            save << attr.typeId << (attr.nullable ? " null," : ",");
+            recordSize += (attr.nullable ? 1 : 0) + attr.type.bytes;
+        }
+        save << "int64)";
+        recordSize += sizeof (int64_t);
+
+        string afl_temp = afl.str();
+        afl.str("");
+        afl << "apply(" << afl_temp << ",scidb4gdal_cell,int64(";
+        if (tdim) afl << "(" << tdim->name << "-(" << t_min << "))*" << nx * ny << "+";
+        afl << "(" << ydim->name << "-(" << y_min << "))*" << nx << "+" << xdim->name << "-(" << x_min << ")))";
         Utils::debug("Performing AFL Query: " + afl.str());
 
-        // Utils::debug("AFL QUERY: " + afl.str());
+        int sessionID = newSession();
+        stringstream ss;
+        string response;
 
         curlBegin();
-        // EXECUTE QUERY  ////////////////////////////
-        ss.str("");
+        // the query contains arithmetic operators, '+' must not be decoded as blank
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
         ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                << "id=" << sessionID
-                << "&query=" << curl_easy_escape(_curl_handle, aflquery.c_str(), 0);
-        // Add auth parameter if using ssl
+                << "id=" << sessionID << "&query=" << escaped << saveParameter(save.str());
+        curl_free(escaped);
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
-
-        // Set the HTTP options URL and the operations
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
-        if (curlPerform() != CURLE_OK) {
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
             curlEnd();
-            return ERR_CREATE_UNKNOWN;
+            releaseSession(sessionID);
+            Utils::error("Cannot read hyperslab of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
         }
         curlEnd();
 
-        releaseSession(sessionID);
-
-        return SUCCESS;
-    }
-
-    StatusCode ShimClient::persistArray(string srcArr, string tarArr) {
-        // create new array
-        int sessionID = newSession();
-
-        stringstream afl;
-        afl << "store(" << srcArr << ", " << tarArr << ")";
-        Utils::debug("Performing AFL Query: " + afl.str());
-
         curlBegin();
-        // EXECUTE QUERY  ////////////////////////////
-        stringstream ss;
-        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                << "id=" << sessionID
-                << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        ss.str("");
+        ss << _host << SHIMENDPOINT_READ_BYTES << "?"
+                << "id=" << sessionID << "&n=0";
         if (_ssl && !_auth.empty())
-            ss << "&auth=" << _auth; // Add auth parameter if using ssl
+            ss << "&auth=" << _auth;
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
-        if (curlPerform() != CURLE_OK) {
+        response = "";
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
             curlEnd();
-            return ERR_GLOBAL_UNKNOWN;
+            releaseSession(sessionID);
+            Utils::error("Cannot read hyperslab of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
         }
         curlEnd();
-
         releaseSession(sessionID);
 
+        // Scatter (values..., position) records into the output buffers
+        if (response.size() % recordSize != 0) {
+            Utils::error("Unexpected response size while reading hyperslab of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        if (mask) memset(mask, 0, n);
+        const char* rec = response.data();
+        const char* end = rec + response.size();
+        for (; rec < end; rec += recordSize) {
+            int64_t pos;
+            memcpy(&pos, rec + recordSize - sizeof (int64_t), sizeof (int64_t));
+            if (pos < 0 || (size_t) pos >= n) continue;
+            if (mask) mask[pos] = 255;
+            const char* v = rec;
+            for (size_t i = 0; i < bands.size(); ++i) {
+                const size_t bytes = array.attrs[bands[i]].type.bytes;
+                if (array.attrs[bands[i]].nullable) {
+                    if ((uint8_t) * v++ != 0xFF) {
+                        v += bytes;
+                        continue;
+                    }
+                }
+                memcpy((uint8_t*) out[i] + (size_t) pos * bytes, v, bytes);
+                v += bytes;
+            }
+        }
         return SUCCESS;
     }
 
-    StatusCode ShimClient::insertInto(SciDBArray& srcArray, SciDBArray& destArray) {
-        // create new array
-        int sessionID = newSession();
+    StatusCode ShimClient::getTimeSeries(SciDBSpatialArray& array, uint8_t nband, const vector<int64_t>& xs, const vector<int64_t>& ys,
+                                         void* out, int64_t t_min, int64_t t_max) {
+        if (nband >= array.attrs.size()) {
+            Utils::error("Requested array band does not exist");
+            return ERR_READ_UNKNOWN;
+        }
+        if (xs.size() != ys.size()) {
+            Utils::error("Invalid locations for time series");
+            return ERR_READ_UNKNOWN;
+        }
+        SciDBDimension* xdim = array.getXDim();
+        SciDBDimension* ydim = array.getYDim();
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*> (&array);
+        SciDBDimension* tdim = starray ? starray->getTDim() : NULL;
+        if (!tdim) {
+            t_min = 0;
+            t_max = 0;
+        }
+        if (t_min > t_max || (tdim && (t_min < tdim->low || t_max > tdim->high))) {
+            Utils::error("Requested time series is outside array boundaries");
+            return ERR_READ_BBOX;
+        }
+        for (size_t i = 0; i < xs.size(); ++i) {
+            if (xs[i] < xdim->low || xs[i] > xdim->high || ys[i] < ydim->low || ys[i] > ydim->high) {
+                Utils::error("Requested location is outside array boundaries");
+                return ERR_READ_BBOX;
+            }
+        }
+
+        SciDBAttribute& attr = array.attrs[nband];
+        const size_t nt = (size_t) (t_max - t_min + 1);
+        const size_t bytes = attr.type.bytes;
+        string naval = attr.noData();
+        Utils::fillValue(out, xs.size() * nt, attr.type, CPLAtof(naval.c_str()));
+
+        stringstream save;
+        save << "(" << attr.typeId << (attr.nullable ? " null" : "") << ",int64,int64,int64)";
+        const size_t v = attr.nullable ? 1 : 0; // null values are preceded by a missing reason byte
+        const size_t recordSize = v + bytes + 3 * sizeof (int64_t);
+
+        for (size_t first = 0; first < xs.size(); first += SHIM_MAX_TIMESERIES_POINTS) {
+            const size_t last = std::min(xs.size(), first + SHIM_MAX_TIMESERIES_POINTS);
+
+            // The same location may be requested several times
+            map<pair<int64_t, int64_t>, vector<size_t> > points;
+            int64_t x_min = xs[first], x_max = xs[first], y_min = ys[first], y_max = ys[first];
+            for (size_t i = first; i < last; ++i) {
+                points[std::make_pair(xs[i], ys[i])].push_back(i);
+                x_min = std::min(x_min, xs[i]);
+                x_max = std::max(x_max, xs[i]);
+                y_min = std::min(y_min, ys[i]);
+                y_max = std::max(y_max, ys[i]);
+            }
+
+            vector<int64_t> lo(array.dims.size()), hi(array.dims.size());
+            for (size_t i = 0; i < array.dims.size(); ++i) {
+                lo[i] = array.dims[i].low;
+                hi[i] = array.dims[i].high;
+            }
+            lo[array.getXDimIdx()] = x_min;
+            hi[array.getXDimIdx()] = x_max;
+            lo[array.getYDimIdx()] = y_min;
+            hi[array.getYDimIdx()] = y_max;
+            if (tdim) {
+                lo[starray->getTDimIdx()] = t_min;
+                hi[starray->getTDimIdx()] = t_max;
+            }
+
+            stringstream afl;
+            afl << "project(filter(between(" << array.name;
+            for (size_t i = 0; i < lo.size(); ++i) afl << "," << lo[i];
+            for (size_t i = 0; i < hi.size(); ++i) afl << "," << hi[i];
+            afl << "),";
+            for (map<pair<int64_t, int64_t>, vector<size_t> >::iterator it = points.begin(); it != points.end(); ++it) {
+                if (it != points.begin()) afl << " or ";
+                afl << "(" << xdim->name << "=" << it->first.first << " and " << ydim->name << "=" << it->first.second << ")";
+            }
+            afl << ")," << attr.name << ")";
+            string afl_temp = afl.str();
+            afl.str("");
+            afl << "apply(" << afl_temp << ",scidb4gdal_x,int64(" << xdim->name << "),scidb4gdal_y,int64(" << ydim->name
+                    << "),scidb4gdal_t," << (tdim ? "int64(" + tdim->name + ")" : string("int64(0)")) << ")";
+            Utils::debug("Performing AFL Query: " + afl.str());
+
+            int sessionID = newSession();
+            stringstream ss;
+            string response;
+
+            curlBegin();
+            char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+            ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                    << "id=" << sessionID << "&query=" << escaped << saveParameter(save.str());
+            curl_free(escaped);
+            if (_ssl && !_auth.empty())
+                ss << "&auth=" << _auth;
+            curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+            curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+            if (!curlPerformSucceeded()) {
+                curlEnd();
+                releaseSession(sessionID);
+                Utils::error("Cannot read time series of array '" + array.name + "'");
+                return ERR_READ_UNKNOWN;
+            }
+            curlEnd();
+
+            curlBegin();
+            ss.str("");
+            ss << _host << SHIMENDPOINT_READ_BYTES << "?"
+                    << "id=" << sessionID << "&n=0";
+            if (_ssl && !_auth.empty())
+                ss << "&auth=" << _auth;
+            curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+            curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+            response = "";
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+            curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+            if (!curlPerformSucceeded()) {
+                curlEnd();
+                releaseSession(sessionID);
+                Utils::error("Cannot read time series of array '" + array.name + "'");
+                return ERR_READ_UNKNOWN;
+            }
+            curlEnd();
+            releaseSession(sessionID);
+
+            // Scatter (value, x, y, t) records into the time series of all matching locations
+            if (response.size() % recordSize != 0) {
+                Utils::error("Unexpected response size while reading time series of array '" + array.name + "'");
+                return ERR_READ_UNKNOWN;
+            }
+            const char* rec = response.data();
+            const char* end = rec + response.size();
+            for (; rec < end; rec += recordSize) {
+                int64_t c[3];
+                memcpy(c, rec + v + bytes, sizeof (c));
+                if (c[2] < t_min || c[2] > t_max || (v && (uint8_t) rec[0] != 0xFF)) continue;
+                map<pair<int64_t, int64_t>, vector<size_t> >::iterator it = points.find(std::make_pair(c[0], c[1]));
+                if (it == points.end()) continue;
+                for (size_t k = 0; k < it->second.size(); ++k) {
+                    memcpy((uint8_t*) out + (it->second[k] * nt + (size_t) (c[2] - t_min)) * bytes, rec + v, bytes);
+                }
+            }
+        }
+        return SUCCESS;
+    }
+
+    StatusCode ShimClient::getTemporalReduction(SciDBSpatioTemporalArray& array, uint8_t nband, const vector<string>& ops, const vector<double*>& out,
+                                                int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max, int64_t t_min, int64_t t_max) {
+        if (nband >= array.attrs.size()) {
+            Utils::error("Requested array band does not exist");
+            return ERR_READ_UNKNOWN;
+        }
+        if (ops.empty() || ops.size() != out.size()) {
+            Utils::error("Invalid temporal reduction");
+            return ERR_READ_UNKNOWN;
+        }
+        SciDBDimension* xdim = array.getXDim();
+        SciDBDimension* ydim = array.getYDim();
+        SciDBDimension* tdim = array.getTDim();
+        if (x_min > x_max || y_min > y_max || t_min > t_max ||
+            x_min < xdim->low || x_max > xdim->high ||
+            y_min < ydim->low || y_max > ydim->high ||
+            t_min < tdim->low || t_max > tdim->high) {
+            Utils::error("Requested array subset is outside array boundaries");
+            return ERR_READ_BBOX;
+        }
+
+        const int64_t nx = x_max - x_min + 1;
+        const size_t n = (size_t) (nx * (y_max - y_min + 1));
+        SciDBAttribute& attr = array.attrs[nband];
+
+        vector<int64_t> lo(array.dims.size()), hi(array.dims.size());
+        for (size_t i = 0; i < array.dims.size(); ++i) {
+            lo[i] = array.dims[i].low;
+            hi[i] = array.dims[i].high;
+        }
+        lo[array.getXDimIdx()] = x_min;
+        hi[array.getXDimIdx()] = x_max;
+        lo[array.getYDimIdx()] = y_min;
+        hi[array.getYDimIdx()] = y_max;
+        lo[array.getTDimIdx()] = t_min;
+        hi[array.getTDimIdx()] = t_max;
+
+        stringstream afl, save;
+        afl << "between(" << array.name;
+        for (size_t i = 0; i < lo.size(); ++i) afl << "," << lo[i];
+        for (size_t i = 0; i < hi.size(); ++i) afl << "," << hi[i];
+        afl << ")";
+
+        // Ignore no data values, aggregates skip null values anyway
+        MD& md = attr.md[""];
+        if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA) != md.end()) {
+            string naval = md[SCIDB4GDAL_DEFAULTMDFIELD_NODATA];
+            boost::algorithm::trim(naval);
+            string afl_temp = afl.str();
+            afl.str("");
+            if (boost::algorithm::iequals(naval, "nan")) {
+                afl << "filter(" << afl_temp << ",not is_nan(" << attr.name << "))";
+            } else if (!naval.empty()) {
+                afl << "filter(" << afl_temp << "," << attr.name << "<>" << naval << ")";
+            } else {
+                afl << afl_temp;
+            }
+        }
+
+        string afl_temp = afl.str();
+        afl.str("");
+        afl << "aggregate(" << afl_temp;
+        for (size_t i = 0; i < ops.size(); ++i) {
+            afl << "," << ((ops[i] == "mean") ? string("avg") : ops[i]) << "(" << attr.name << ") as scidb4gdal_r" << i;
+            std::fill(out[i], out[i] + n, (ops[i] == "count") ? 0 : std::numeric_limits<double>::quiet_NaN());
+        }
+        afl << "," << ydim->name << "," << xdim->name << ")";
+
+        // Cast all results to double and attach the linear cell position within the box
+        afl_temp = afl.str();
+        afl.str("");
+        afl << "project(apply(" << afl_temp;
+        for (size_t i = 0; i < ops.size(); ++i) afl << ",scidb4gdal_d" << i << ",double(scidb4gdal_r" << i << ")";
+        afl << ",scidb4gdal_cell,int64((" << ydim->name << "-(" << y_min << "))*" << nx << "+" << xdim->name << "-(" << x_min << ")))";
+        save << "(";
+        for (size_t i = 0; i < ops.size(); ++i) {
+            afl << ",scidb4gdal_d" << i;
+            save << "double null,";
+        }
+        afl << ",scidb4gdal_cell)";
+        save << "int64)";
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        int sessionID = newSession();
+        stringstream ss;
+        string response;
+
+        curlBegin();
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID << "&query=" << escaped << saveParameter(save.str());
+        curl_free(escaped);
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute temporal reduction of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
+
+        curlBegin();
+        ss.str("");
+        ss << _host << SHIMENDPOINT_READ_BYTES << "?"
+                << "id=" << sessionID << "&n=0";
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        response = "";
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute temporal reduction of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
+        releaseSession(sessionID);
+
+        // Records are (null flag, double) per reduction followed by the position
+        const size_t recordSize = ops.size() * (1 + sizeof (double)) + sizeof (int64_t);
+        if (response.size() % recordSize != 0) {
+            Utils::error("Unexpected response size while computing temporal reduction of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        const char* rec = response.data();
+        const char* end = rec + response.size();
+        for (; rec < end; rec += recordSize) {
+            int64_t pos;
+            memcpy(&pos, rec + recordSize - sizeof (int64_t), sizeof (int64_t));
+            if (pos < 0 || (size_t) pos >= n) continue;
+            for (size_t i = 0; i < ops.size(); ++i) {
+                const char* v = rec + i * (1 + sizeof (double));
+                if ((int8_t) v[0] != -1) continue; // null, e.g. min of an empty group
+                memcpy(&out[i][pos], v + 1, sizeof (double));
+            }
+        }
+        return SUCCESS;
+    }
+
+    AFLQueryTemplate ShimClient::prepareDataQuery(SciDBSpatialArray& array, uint8_t nband, const string& arr,
+                                                  bool use_subarray, bool sparse) {
+        int8_t x_idx = array.getXDimIdx();
+        int8_t y_idx = array.getYDimIdx();
+
+        // Placeholders are a control character followed by the parameter id, see AFLQueryParameter
+        const char mark = '\x1f';
+        const string xmin = string(1, mark) + (char)('0' + AFL_PARAM_XMIN);
+        const string ymin = string(1, mark) + (char)('0' + AFL_PARAM_YMIN);
+        const string xmax = string(1, mark) + (char)('0' + AFL_PARAM_XMAX);
+        const string ymax = string(1, mark) + (char)('0' + AFL_PARAM_YMAX);
+        const string xext = string(1, mark) + (char)('0' + AFL_PARAM_XEXTENT);
+        const string yext = string(1, mark) + (char)('0' + AFL_PARAM_YEXTENT);
+
+        SciDBDimension* xdim = array.getXDim();
+        SciDBDimension* ydim = array.getYDim();
+
+        stringstream afl;
+        afl << "project(" << (use_subarray ? "subarray(" : "between(") << arr << ",";
+        if (x_idx > y_idx)
+            afl << ymin << "," << xmin << "," << ymax << "," << xmax;
+        else
+            afl << xmin << "," << ymin << "," << xmax << "," << ymax;
+        afl << ")," << array.attrs[nband].name << ")";
+
+        if (sparse) {
+            /* Only non-empty cells are transferred, each with its position in the block. The position does not depend on the
+             * dimension ordering, empty cells are filled with no data values client-side. subarray() shifts coordinates to 0. */
+            string afl_temp = afl.str();
+            afl.str("");
+            afl << "apply(" << afl_temp << ",scidb4gdal_cell,int64(";
+            if (use_subarray)
+                afl << ydim->name << "*(" << xext << "+1)+" << xdim->name;
+            else
+                afl << "(" << ydim->name << "-(" << ymin << "))*(" << xext << "+1)+" << xdim->name << "-(" << xmin << ")";
+            afl << "))";
+        }
+        // Dense blocks of arrays with x preceding y are transposed client-side, see getData()
+
+        // Null values of nullable attributes are replaced with the no data value client-side, see getData()
+
+        string query = afl.str();
+        Utils::debug("Prepared AFL Query: " + query);
+
+        // Split at placeholders and escape literal parts
+        AFLQueryTemplate out;
+        string segment = "&query=";
+        size_t start = 0;
+        for (size_t pos = query.find(mark); pos != string::npos; pos = query.find(mark, start)) {
+            char* escaped = curl_easy_escape(_curl_handle, query.substr(start, pos - start).c_str(), 0);
+            segment.append(escaped);
+            curl_free(escaped);
+            out.segments.push_back(segment);
+            out.params.push_back((AFLQueryParameter)(query[pos + 1] - '0'));
+            segment = "";
+            start = pos + 2;
+        }
+        char* escaped = curl_easy_escape(_curl_handle, query.substr(start).c_str(), 0);
+        segment.append(escaped);
+        curl_free(escaped);
+
+        stringstream save, ss;
+        save << "(" << array.attrs[nband].typeId;
+        if (array.attrs[nband].nullable) save << " null";
+        if (sparse) save << ",int64";
+        save << ")";
+        ss << saveParameter(save.str());
+        segment.append(ss.str());
+        out.segments.push_back(segment);
+
+        return out;
+    }
+
+    StatusCode ShimClient::createTempArray(SciDBSpatialArray& array) {
+        if (array.name == "") {
+            Utils::error("Cannot create unnamed arrays");
+            return ERR_CREATE_INVALIDARRAYNAME;
+        }
+        bool exists;
+        arrayExists(array.name, exists);
+        if (exists) {
+            if (!(_cp->type == ST_SERIES || _cp->type == ST_ARRAY ||
+                  _cp->type == S_ARRAY)) {
+                Utils::error("Array '" + array.name +
+                             "' already exists in SciDB database");
+                return ERR_CREATE_ARRAYEXISTS;
+            }
+        }
+
+        if (array.attrs.size() == 0) {
+            Utils::error("No array attributes specified");
+            return ERR_CREATE_UNKNOWN;
+        }
+
+        stringstream ss;
+
+        int sessionID = newSession();
+
+        // Build afl query, e.g. CREATE ARRAY A <x: double, err: double> [i=0:99,10,0,
+        // j=0:99,10,0];
+        stringstream afl;
+        afl << "CREATE TEMP ARRAY " << array.name << SCIDB4GDAL_ARRAYSUFFIX_TEMP;
+
+        afl << array.getSchemaString();
+
+
+        // Append attribute specification
+        //         afl << " <";
+        //         for (uint32_t i = 0; i < array.attrs.size(); ++i) {
+        //             afl << array.attrs[i].name << ": " << array.attrs[i].typeId;
+        //             if (i != array.attrs.size() - 1) {
+        //                 afl << ",";
+        //             } else {
+        //                 afl << ">";
+        //             }
+        //         }
+        //
+        //         // Append dimension spec
+        //         afl << " [";
+        //         for (uint32_t i = 0; i < array.dims.size(); ++i) {
+        //             string dimHigh = "";
+        //             if (array.dims[i].high == SCIDB_MAX_DIM_INDEX) {
+        //                 dimHigh = "*";
+        //             } else {
+        //                 dimHigh = boost::lexical_cast<string>(array.dims[i].high);
+        //             }
+        //
+        //             // TODO: Overlap
+        //             afl << array.dims[i].name << "=" << array.dims[i].low << ":" << dimHigh
+        //                 << "," << array.dims[i].chunksize << "," << 0;
+        //             if (i != array.dims.size() - 1) {
+        //                 afl << ", ";
+        //             } else {
+        //                 afl << "]";
+        //             }
+        //         }
+
+
+        string aflquery = afl.str();
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        // Utils::debug("AFL QUERY: " + afl.str());
+
+        curlBegin();
+        // EXECUTE QUERY  ////////////////////////////
+        ss.str("");
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID
+                << "&query=" << curl_easy_escape(_curl_handle, aflquery.c_str(), 0);
+        // Add auth parameter if using ssl
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+
+        // Set the HTTP options URL and the operations
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        if (curlPerform() != CURLE_OK) {
+            curlEnd();
+            return ERR_CREATE_UNKNOWN;
+        }
+        curlEnd();
+
+        releaseSession(sessionID);
+
+        return SUCCESS;
+    }
+
+    StatusCode ShimClient::persistArray(string srcArr, string tarArr) {
+        // create new array
+        int sessionID = newSession();
+
+        stringstream afl;
+        afl << "store(" << srcArr << ", " << tarArr << ")";
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        curlBegin();
+        // EXECUTE QUERY  ////////////////////////////
+        stringstream ss;
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID
+                << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth; // Add auth parameter if using ssl
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        if (curlPerform() != CURLE_OK) {
+            curlEnd();
+            return ERR_GLOBAL_UNKNOWN;
+        }
+        curlEnd();
+
+        releaseSession(sessionID);
+
+        return SUCCESS;
+    }
+
+    StatusCode ShimClient::appendArray(string srcArr, string tarArr) {
+        int sessionID = newSession();
+
+        stringstream afl;
+        afl << "insert(" << srcArr << ", " << tarArr << ")";
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        curlBegin();
+        stringstream ss;
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID
+                << "&query=" << escaped;
+        curl_free(escaped);
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth; // Add auth parameter if using ssl
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        // a rejected insertion must not be taken for a successful one, callers remove the source array afterwards
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot insert array '" + srcArr + "' into '" + tarArr + "'");
+            return ERR_GLOBAL_UNKNOWN;
+        }
+        curlEnd();
+
+        releaseSession(sessionID);
+
+        return SUCCESS;
+    }
+
+    string ShimClient::filterNoData(SciDBArray& array, const string& afl) {
+        stringstream afl_filternonNA, afl_predicateNA;
+
+        // for each attribute get name and assigned NA value and add them to the
+        // boolean statement (if NO_DATA was set)
+        // check if NODATA value exists...
+        unsigned int noNA = 0;
+        for (uint32_t i = 0; i < array.attrs.size(); ++i) {
+            string naVal = array.attrs[i].md[""]["NODATA"]; // if not exists then an empty string will be returned in this case
+            if (naVal.empty()) {
+                ++noNA;
+                continue;
+            }
+
+            if (array.attrs[i].type.isInteger) {
+                long v = boost::lexical_cast<long>(naVal);
+                afl_predicateNA << array.attrs[i].name << " = " << v;
+            } else if (array.attrs[i].type.isFloatingPoint) {
+                double v = boost::lexical_cast<double>(naVal);
+                afl_predicateNA << array.attrs[i].name << " = " << std::setprecision(numeric_limits<double>::digits10) << v;
+            } else continue;
+
+            afl_predicateNA << " OR ";
+
+        }
+        afl_predicateNA << " FALSE ";
+        if (noNA < array.attrs.size()) { // at least one nodata value was set
+            afl_filternonNA << "filter(" << afl << ", NOT (" << afl_predicateNA.str() << "))";
+
+        } else {
+            afl_filternonNA << afl;
+        }
+        return afl_filternonNA.str();
+    }
+
+    StatusCode ShimClient::insertInto(SciDBArray& srcArray, SciDBArray& destArray) {
+        // create new array
+        int sessionID = newSession();
         string collArr = destArray.name; // array name in which we want to store the data
         string tmpArr = srcArray.name; // array name with the source data
 
@@ -1491,44 +2180,12 @@ namespace scidb4gdal {
 
 
         /* 2016-05-17: Moved filtering of NA values from insertData() to here  */
-
-        stringstream afl_filternonNA, afl_predicateNA;
-
-        // for each attribute get name and assigned NA value and add them to the
-        // boolean statement (if NO_DATA was set)
-        // check if NODATA value exists...
-        unsigned int noNA = 0;
-        for (uint32_t i = 0; i < srcArray.attrs.size(); ++i) {
-            string naVal = srcArray.attrs[i].md[""]["NODATA"]; // if not exists then an empty string will be returned in this case
-            if (naVal.empty()) {
-                ++noNA;
-                continue;
-            }
-
-            if (Utils::scidbTypeIdIsInteger(srcArray.attrs[i].typeId)) {
-                long v = boost::lexical_cast<long>(naVal);
-                afl_predicateNA << srcArray.attrs[i].name << " = " << v;
-            } else if (Utils::scidbTypeIdIsFloatingPoint(srcArray.attrs[i].typeId)) {
-                double v = boost::lexical_cast<double>(naVal);
-                afl_predicateNA << srcArray.attrs[i].name << " = " << std::setprecision(numeric_limits<double>::digits10) << v;
-            } else continue;
-
-            afl_predicateNA << " OR ";
-
-        }
-        afl_predicateNA << " FALSE ";
-        if (noNA < srcArray.attrs.size()) { // at least one nodata value was set
-            afl_filternonNA << "filter(" << redimension << ", NOT (" << afl_predicateNA.str() << "))";
-
-        } else {
-            afl_filternonNA << redimension;
-        }
-        /* 2016-05-17: END */
+        string afl_filternonNA = filterNoData(srcArray, redimension);
 
 
 
         stringstream afl;
-        afl << "insert(" << afl_filternonNA.str() << ", " << collArr << ")";
+        afl << "insert(" << afl_filternonNA << ", " << collArr << ")";
         Utils::debug("Performing AFL Query: " + afl.str());
 
         curlBegin();
@@ -1566,25 +2223,7 @@ namespace scidb4gdal {
         return !(std::isalnum(c) || c == '/' || c == '_' || c == '-' || c == '.');
     }
 
-    StatusCode ShimClient::insertData(SciDBSpatialArray& array, void* inChunk,
-                                      int32_t x_min, int32_t y_min, int32_t x_max,
-                                      int32_t y_max) {
-        // TODO: Do some checks
-
-        // Shim create session
-        int sessionID = newSession();
-
-        // Shim upload file from binary stream
-        string format = array.getFormatString();
-
-        // Get total size in bytes of one pixel, i.e. sum of attribute sizes
-        size_t pixelSize = 0;
-        uint32_t nx = (1 + x_max - x_min);
-        uint32_t ny = (1 + y_max - y_min);
-        for (uint32_t i = 0; i < array.attrs.size(); ++i)
-            pixelSize += Utils::scidbTypeIdBytes(array.attrs[i].typeId);
-        size_t totalSize = pixelSize * nx * ny;
-
+    StatusCode ShimClient::uploadFile(int sessionID, void* data, size_t totalSize, string& remoteFilename) {
         Utils::debug("Upload file size " + boost::lexical_cast<string>(totalSize >> 10 >> 10) + "MB");
 
         // UPLOAD FILE ////////////////////////////
@@ -1607,12 +2246,11 @@ namespace scidb4gdal {
         // Load file from buffer instead of file!
         // Form HTTP POST, first two pointers next the KVP for the form
         curl_formadd(&formpost, &lastptr, CURLFORM_COPYNAME, "file", CURLFORM_BUFFER,
-                     SCIDB4GDAL_DEFAULT_UPLOAD_FILENAME, CURLFORM_BUFFERPTR, inChunk,
+                     SCIDB4GDAL_DEFAULT_UPLOAD_FILENAME, CURLFORM_BUFFERPTR, data,
                      CURLFORM_BUFFERLENGTH, totalSize, CURLFORM_CONTENTTYPE,
                      "application/octet-stream", CURLFORM_END);
 
         curlBegin();
-        string remoteFilename = "";
         // curl_easy_setopt(_curl_handle, CURLOPT_FOLLOWLOCATION, 1L);
 
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
@@ -1622,6 +2260,7 @@ namespace scidb4gdal {
 
         if (curlPerform() != CURLE_OK) {
             curlEnd();
+            curl_formfree(formpost);
             return ERR_CREATE_UNKNOWN;
         }
         curlEnd();
@@ -1633,6 +2272,34 @@ namespace scidb4gdal {
                                             isIllegalFilenameCharacter),
                              remoteFilename.end());
 
+        return SUCCESS;
+    }
+
+    StatusCode ShimClient::insertData(SciDBSpatialArray& array, void* inChunk,
+                                      int32_t x_min, int32_t y_min, int32_t x_max,
+                                      int32_t y_max) {
+        // TODO: Do some checks
+
+        // Shim create session
+        int sessionID = newSession();
+
+        // Shim upload file from binary stream
+        string format = array.getFormatString();
+
+        // Get total size in bytes of one pixel, i.e. sum of attribute sizes
+        size_t pixelSize = 0;
+        uint32_t nx = (1 + x_max - x_min);
+        uint32_t ny = (1 + y_max - y_min);
+        for (uint32_t i = 0; i < array.attrs.size(); ++i)
+            pixelSize += array.attrs[i].type.bytes;
+        size_t totalSize = pixelSize * nx * ny;
+
+        string remoteFilename = "";
+        if (uploadFile(sessionID, inChunk, totalSize, remoteFilename) != SUCCESS) {
+            releaseSession(sessionID);
+            return ERR_CREATE_UNKNOWN;
+        }
+
         // Load data from file to SciDB array
         stringstream afl_input;
 
@@ -1664,94 +2331,407 @@ namespace scidb4gdal {
 
 
         stringstream afl;
-        afl << "insert(" << afl_redimension.str() << ", " << array.name << SCIDB4GDAL_ARRAYSUFFIX_TEMP << ")";
+        afl << "insert(" << afl_redimension.str() << ", " << array.name << SCIDB4GDAL_ARRAYSUFFIX_TEMP << ")";
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        curlBegin();
+        stringstream ss;
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID
+                << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        // Add auth parameter if using ssl
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        if (curlPerform() != CURLE_OK) {
+            curlEnd();
+            Utils::warn("Insertion or redimensioning of tile failed.");
+            return ERR_CREATE_UNKNOWN;
+        }
+        curlEnd();
+
+        // Release session
+        releaseSession(sessionID);
+
+        return SUCCESS;
+    }
+
+    StatusCode ShimClient::insertSlice(SciDBSpatioTemporalArray& array, void* inChunk, int64_t t,
+                                       int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max) {
+        int sessionID = newSession();
+
+        string format = array.getFormatString();
+        size_t pixelSize = 0;
+        for (uint32_t i = 0; i < array.attrs.size(); ++i)
+            pixelSize += array.attrs[i].type.bytes;
+        size_t totalSize = pixelSize * (1 + x_max - x_min) * (1 + y_max - y_min);
+
+        string remoteFilename = "";
+        if (uploadFile(sessionID, inChunk, totalSize, remoteFilename) != SUCCESS) {
+            releaseSession(sessionID);
+            return ERR_CREATE_UNKNOWN;
+        }
+
+        // the tile already has target coordinates, including a single temporal slice
+        SciDBSpatioTemporalArray array_tile = array;
+        array_tile.getXDim()->start = x_min;
+        array_tile.getXDim()->low = x_min;
+        array_tile.getXDim()->high = x_max;
+        array_tile.getXDim()->length = x_max - x_min + 1;
+
+        array_tile.getYDim()->start = y_min;
+        array_tile.getYDim()->low = y_min;
+        array_tile.getYDim()->high = y_max;
+        array_tile.getYDim()->length = y_max - y_min + 1;
+
+        array_tile.getTDim()->start = t;
+        array_tile.getTDim()->low = t;
+        array_tile.getTDim()->high = t;
+        array_tile.getTDim()->length = 1;
+
+        stringstream afl_input;
+        afl_input << "input(" << array_tile.getSchemaString() << ",'" << remoteFilename << "', -2, '" << format << "')";
+
+        stringstream afl;
+        afl << "insert(" << filterNoData(array, "redimension(" + afl_input.str() + "," + array.getSchemaString() + ")") << ", " << array.name << ")";
         Utils::debug("Performing AFL Query: " + afl.str());
 
         curlBegin();
-        ss.str("");
+        stringstream ss;
         ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
                 << "id=" << sessionID
                 << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
-        // Add auth parameter if using ssl
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
-        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
-        if (curlPerform() != CURLE_OK) {
+        if (!curlPerformSucceeded()) {
             curlEnd();
-            Utils::warn("Insertion or redimensioning of tile failed.");
+            releaseSession(sessionID);
+            Utils::warn("Insertion of tile into temporal slice failed.");
             return ERR_CREATE_UNKNOWN;
         }
         curlEnd();
 
-        // Release session
         releaseSession(sessionID);
 
         return SUCCESS;
     }
 
-    StatusCode ShimClient::getAttributeStats(SciDBSpatialArray& array,
-                                             uint8_t nband,
-                                             SciDBAttributeStats& out) {
-        if (nband >= array.attrs.size()) {
-            Utils::error("Invalid attribute index");
+    StatusCode ShimClient::getAttributeStats(SciDBSpatialArray& array, vector<SciDBAttributeStats>& out, double sample) {
+        vector<vector<SciDBAttributeStats> > res;
+        StatusCode code = computeAttributeStats(array, -1, -1, res, sample);
+        if (code == SUCCESS) out = res[0];
+        return code;
+    }
+
+    StatusCode ShimClient::getAttributeStats(SciDBSpatioTemporalArray& array, int64_t t_min, int64_t t_max,
+                                             vector<vector<SciDBAttributeStats> >& out, double sample) {
+        SciDBDimension* tdim = array.getTDim();
+        if (t_min > t_max || t_min < tdim->low || t_max > tdim->high) {
+            Utils::error("Requested temporal range is outside array boundaries");
+            return ERR_READ_BBOX;
         }
+        return computeAttributeStats(array, t_min, t_max, out, sample);
+    }
 
-        int sessionID = newSession();
+    StatusCode ShimClient::computeAttributeStats(SciDBSpatialArray& array, int64_t t_min, int64_t t_max,
+                                                 vector<vector<SciDBAttributeStats> >& out, double sample) {
+        const size_t nattrs = array.attrs.size();
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(&array);
+        const bool sliced = starray && t_min >= 0;
+        const size_t ngroups = sliced ? (size_t) (t_max - t_min + 1) : 1;
+        out.assign(ngroups, vector<SciDBAttributeStats>(nattrs));
+        for (size_t g = 0; g < ngroups; ++g) {
+            for (size_t i = 0; i < nattrs; ++i) {
+                out[g][i].min = out[g][i].max = out[g][i].mean = out[g][i].stdev = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+        if (nattrs == 0) return SUCCESS;
 
-        stringstream ss, afl;
-        string aname = array.attrs[nband].name;
+        // Temporal slices are selected by between() over the spatial extent of the data
+        stringstream input;
+        if (sliced) {
+            vector<int64_t> lo(array.dims.size()), hi(array.dims.size());
+            for (size_t i = 0; i < array.dims.size(); ++i) {
+                lo[i] = array.dims[i].low;
+                hi[i] = array.dims[i].high;
+            }
+            lo[starray->getTDimIdx()] = t_min;
+            hi[starray->getTDimIdx()] = t_max;
+            input << "between(" << array.name;
+            for (size_t i = 0; i < lo.size(); ++i) input << "," << lo[i];
+            for (size_t i = 0; i < hi.size(); ++i) input << "," << hi[i];
+            input << ")";
+        } else {
+            input << array.name;
+        }
 
-        // create an output table based on the name of array
-        // min(), max(),avg(),stdev()
-        // and save it as 4 double values
-        afl << "aggregate(" << array.name << ",min(" << aname << "),max(" << aname << "),avg(" << aname << "),stdev(" << aname << "))";
+        // No data values become null per attribute, a filter would drop the cells of all other attributes
+        stringstream afl, save;
+        afl << "apply(";
+        if (sample < 1)
+            afl << "bernoulli(" << input.str() << "," << sample << "," << SCIDB4GDAL_STATS_SAMPLE_SEED << ")";
+        else
+            afl << input.str();
+        for (size_t i = 0; i < nattrs; ++i) {
+            SciDBAttribute& attr = array.attrs[i];
+            string naval;
+            MD& md = attr.md[""];
+            if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA) != md.end()) {
+                naval = md[SCIDB4GDAL_DEFAULTMDFIELD_NODATA];
+                boost::algorithm::trim(naval);
+            }
+            afl << ",scidb4gdal_v" << i << ",";
+            if (boost::algorithm::iequals(naval, "nan"))
+                afl << "iif(is_nan(" << attr.name << "),null," << attr.name << ")";
+            else if (!naval.empty())
+                afl << "iif(" << attr.name << "=" << naval << ",null," << attr.name << ")";
+            else
+                afl << attr.name;
+        }
+        afl << ")";
+
+        string afl_temp = afl.str();
+        afl.str("");
+        afl << "aggregate(" << afl_temp;
+        for (size_t i = 0; i < nattrs; ++i) {
+            afl << ",min(scidb4gdal_v" << i << ") as scidb4gdal_min" << i
+                << ",max(scidb4gdal_v" << i << ") as scidb4gdal_max" << i
+                << ",avg(scidb4gdal_v" << i << ") as scidb4gdal_avg" << i
+                << ",stdev(scidb4gdal_v" << i << ") as scidb4gdal_sd" << i;
+        }
+        if (sliced) afl << "," << starray->getTDim()->name; // one record per slice
+        afl << ")";
+
+        // Cast all results to double, min and max keep the type of the attribute otherwise
+        afl_temp = afl.str();
+        afl.str("");
+        afl << "project(apply(" << afl_temp;
+        const char* ops[] = {"min", "max", "avg", "sd"};
+        for (size_t i = 0; i < nattrs; ++i) {
+            for (int k = 0; k < 4; ++k)
+                afl << ",scidb4gdal_d" << ops[k] << i << ",double(scidb4gdal_" << ops[k] << i << ")";
+        }
+        if (sliced) afl << ",scidb4gdal_t,int64(" << starray->getTDim()->name << ")";
+        afl << ")";
+        save << "(";
+        for (size_t i = 0; i < nattrs; ++i) {
+            for (int k = 0; k < 4; ++k) {
+                afl << ",scidb4gdal_d" << ops[k] << i;
+                save << ((i == 0 && k == 0) ? "" : ",") << "double null";
+            }
+        }
+        if (sliced) {
+            afl << ",scidb4gdal_t";
+            save << ",int64";
+        }
+        afl << ")";
+        save << ")";
         Utils::debug("Performing AFL Query: " + afl.str());
 
-        ss.str();
+        int sessionID = newSession();
+        stringstream ss;
+        string response;
+
+        curlBegin();
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
         ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
-                << "id=" << sessionID << "&query=" << afl.str() << "&save="
-                << "(double,double,double,double)";
-        // Add auth parameter if using ssl
+                << "id=" << sessionID << "&query=" << escaped << saveParameter(save.str());
+        curl_free(escaped);
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
-
-        curlBegin();
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
-        curlPerform();
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute statistics of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
         curlEnd();
 
         curlBegin();
-        // READ BYTES  ////////////////////////////
         ss.str("");
         ss << _host << SHIMENDPOINT_READ_BYTES << "?"
                 << "id=" << sessionID << "&n=0";
-        // Add auth parameter if using ssl
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        response = "";
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute statistics of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
+        releaseSession(sessionID);
 
-        struct SingleAttributeChunk data;
-        data.memory = (char*) malloc(sizeof (double) * 4);
-        data.size = 0;
+        // Records of (null flag, double) values, ordered min, max, mean, sd per attribute, followed by the
+        // temporal index if grouped by slices. Slices without any cell are missing, but at least one slice is not.
+        const size_t recordSize = nattrs * 4 * (1 + sizeof (double)) + (sliced ? sizeof (int64_t) : 0);
+        if (response.empty() || response.size() % recordSize != 0 || (!sliced && response.size() != recordSize)) {
+            Utils::error("Unexpected response size while computing statistics of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        const char* rec = response.data();
+        const char* end = rec + response.size();
+        for (; rec < end; rec += recordSize) {
+            size_t g = 0;
+            if (sliced) {
+                int64_t t;
+                memcpy(&t, rec + recordSize - sizeof (int64_t), sizeof (int64_t));
+                if (t < t_min || t > t_max) continue;
+                g = (size_t) (t - t_min);
+            }
+            const char* v = rec;
+            for (size_t i = 0; i < nattrs; ++i) {
+                double* fields[] = {&out[g][i].min, &out[g][i].max, &out[g][i].mean, &out[g][i].stdev};
+                for (int k = 0; k < 4; ++k, v += 1 + sizeof (double)) {
+                    if ((int8_t) v[0] != -1) continue; // null, i.e. no valid cell
+                    memcpy(fields[k], v + 1, sizeof (double));
+                }
+            }
+        }
+        return SUCCESS;
+    }
 
-        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, responseBinaryCallback);
-        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, (void*) &data);
-        curlPerform();
-        curlEnd();
+    StatusCode ShimClient::getAttributeHistogram(SciDBSpatialArray& array, uint8_t nband, SciDBHistogram& hist, double sample, int64_t t) {
+        if (nband >= array.attrs.size()) {
+            Utils::error("Invalid attribute index");
+            return ERR_READ_UNKNOWN;
+        }
+        const int64_t nbuckets = (int64_t) hist.counts.size();
+        if (nbuckets == 0 || !(hist.max > hist.min)) {
+            Utils::error("Invalid histogram buckets");
+            return ERR_READ_UNKNOWN;
+        }
+        std::fill(hist.counts.begin(), hist.counts.end(), 0);
+        hist.approx = sample < 1;
+
+        SciDBAttribute& attr = array.attrs[nband];
+        stringstream input;
+        SciDBSpatioTemporalArray* starray = dynamic_cast<SciDBSpatioTemporalArray*>(&array);
+        if (starray && t >= 0) {
+            // only the given temporal slice
+            vector<int64_t> lo(array.dims.size()), hi(array.dims.size());
+            for (size_t i = 0; i < array.dims.size(); ++i) {
+                lo[i] = array.dims[i].low;
+                hi[i] = array.dims[i].high;
+            }
+            lo[starray->getTDimIdx()] = hi[starray->getTDimIdx()] = t;
+            input << "between(" << array.name;
+            for (size_t i = 0; i < lo.size(); ++i) input << "," << lo[i];
+            for (size_t i = 0; i < hi.size(); ++i) input << "," << hi[i];
+            input << ")";
+        } else {
+            input << array.name;
+        }
+
+        stringstream afl, save;
+        afl << std::setprecision(17);
+        afl << "filter(";
+        if (sample < 1)
+            afl << "bernoulli(" << input.str() << "," << sample << "," << SCIDB4GDAL_STATS_SAMPLE_SEED << ")";
+        else
+            afl << input.str();
+        afl << "," << attr.name << " is not null and not is_nan(double(" << attr.name << "))";
+        string naval;
+        MD& md = attr.md[""];
+        if (md.find(SCIDB4GDAL_DEFAULTMDFIELD_NODATA) != md.end()) {
+            naval = md[SCIDB4GDAL_DEFAULTMDFIELD_NODATA];
+            boost::algorithm::trim(naval);
+        }
+        if (!naval.empty() && !boost::algorithm::iequals(naval, "nan"))
+            afl << " and " << attr.name << "<>" << naval;
+        afl << ")";
+
+        // Bucket index as computed by GDALRasterBand::GetHistogram()
+        string afl_temp = afl.str();
+        afl.str("");
+        afl << "apply(" << afl_temp << ",scidb4gdal_b,int64(floor((double(" << attr.name << ")-(" << hist.min << "))*"
+            << ((double) nbuckets / (hist.max - hist.min)) << ")))";
+        afl_temp = afl.str();
+        afl.str("");
+        if (hist.includeOutOfRange)
+            afl << "apply(" << afl_temp << ",scidb4gdal_bin,iif(scidb4gdal_b<0,0,iif(scidb4gdal_b>=" << nbuckets << "," << nbuckets - 1 << ",scidb4gdal_b)))";
+        else
+            afl << "apply(filter(" << afl_temp << ",scidb4gdal_b>=0 and scidb4gdal_b<" << nbuckets << "),scidb4gdal_bin,scidb4gdal_b)";
+
+        // Count per bucket and attach the bucket index
+        afl_temp = afl.str();
+        afl.str("");
+        afl << "apply(redimension(" << afl_temp << ",<scidb4gdal_n:uint64 null>[scidb4gdal_bin=0:" << nbuckets - 1 << ","
+            << nbuckets << ",0],count(*) as scidb4gdal_n),scidb4gdal_i,scidb4gdal_bin)";
+        save << "(uint64 null,int64)";
+        Utils::debug("Performing AFL Query: " + afl.str());
 
-        out.min = ((double*) data.memory)[0];
-        out.max = ((double*) data.memory)[1];
-        out.mean = ((double*) data.memory)[2];
-        out.stdev = ((double*) data.memory)[3];
+        int sessionID = newSession();
+        stringstream ss;
+        string response;
 
-        free(data.memory);
+        curlBegin();
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID << "&query=" << escaped << saveParameter(save.str());
+        curl_free(escaped);
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute histogram of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
 
+        curlBegin();
+        ss.str("");
+        ss << _host << SHIMENDPOINT_READ_BYTES << "?"
+                << "id=" << sessionID << "&n=0";
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        response = "";
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (!curlPerformSucceeded()) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::error("Cannot compute histogram of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
         releaseSession(sessionID);
 
+        // Records are (null flag, count, bucket index), empty buckets are missing
+        const size_t recordSize = 1 + sizeof (uint64_t) + sizeof (int64_t);
+        if (response.size() % recordSize != 0) {
+            Utils::error("Unexpected response size while computing histogram of array '" + array.name + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        const char* rec = response.data();
+        const char* end = rec + response.size();
+        for (; rec < end; rec += recordSize) {
+            if ((int8_t) rec[0] != -1) continue;
+            int64_t bin;
+            memcpy(&bin, rec + 1 + sizeof (uint64_t), sizeof (int64_t));
+            if (bin < 0 || bin >= nbuckets) continue;
+            memcpy(&hist.counts[bin], rec + 1, sizeof (uint64_t));
+        }
         return SUCCESS;
     }
 
@@ -1767,13 +2747,13 @@ namespace scidb4gdal {
         Utils::debug("Performing AFL Query: " + afl.str());
 
         // 	createSHIMExecuteString(ss, sessionID, afl);
+        curlBegin();
         ss.str();
-        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?" << "id=" << sessionID << "&query=" << afl.str() << "&save=" << "(int64)";
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?" << "id=" << sessionID << "&query=" << afl.str() << saveParameter("(int64)");
         // Add auth parameter if using ssl
         if (_ssl && !_auth.empty())
             ss << "&auth=" << _auth;
 
-        curlBegin();
         curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
         curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
         curlPerform();
@@ -1814,6 +2794,72 @@ namespace scidb4gdal {
         return SUCCESS;
     }
 
+    StatusCode ShimClient::getArrayVersion(const string& inArrayName, string& out) {
+        stringstream ss, afl;
+        string response;
+
+        int sessionID = newSession();
+
+        afl << "project(apply(aggregate(versions(" << inArrayName << "),max(version_id) as v,max(timestamp) as ts),"
+                << "v_i64,int64(v),ts_s,string(ts)),v_i64,ts_s)";
+        Utils::debug("Performing AFL Query: " + afl.str());
+
+        curlBegin();
+        char* escaped = curl_easy_escape(_curl_handle, afl.str().c_str(), 0);
+        ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
+                << "id=" << sessionID << "&query=" << escaped << saveParameter("(int64 null,string null)");
+        curl_free(escaped);
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (curlPerform() != CURLE_OK) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::debug("Cannot get the version of array '" + inArrayName + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
+
+        curlBegin();
+        ss.str("");
+        ss << _host << SHIMENDPOINT_READ_BYTES << "?"
+                << "id=" << sessionID << "&n=0";
+        if (_ssl && !_auth.empty())
+            ss << "&auth=" << _auth;
+        curl_easy_setopt(_curl_handle, CURLOPT_URL, ss.str().c_str());
+        curl_easy_setopt(_curl_handle, CURLOPT_HTTPGET, 1);
+        response = "";
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEFUNCTION, &responseToStringCallback);
+        curl_easy_setopt(_curl_handle, CURLOPT_WRITEDATA, &response);
+        if (curlPerform() != CURLE_OK) {
+            curlEnd();
+            releaseSession(sessionID);
+            Utils::debug("Cannot get the version of array '" + inArrayName + "'");
+            return ERR_READ_UNKNOWN;
+        }
+        curlEnd();
+        releaseSession(sessionID);
+
+        // Arrays without any version yield null values
+        BinaryReader bin(response);
+        bool vnull, tsnull;
+        int64_t v = 0;
+        string ts;
+        if (!(bin.readNullFlag(vnull) && bin.readInt64(v) && bin.readNullFlag(tsnull) && bin.readString(ts)) || !bin.eof()) {
+            Utils::debug("Cannot parse the version of array '" + inArrayName + "'");
+            return ERR_GLOBAL_PARSE;
+        }
+        if (vnull) {
+            out = "0";
+            return SUCCESS;
+        }
+        out = boost::lexical_cast<string>(v) + (tsnull ? string("") : "@" + ts);
+        return SUCCESS;
+    }
+
     StatusCode ShimClient::updateSRS(SciDBSpatialArray& array) {
 
         if (!hasSCIDB4GEO()) {
@@ -1953,8 +2999,7 @@ namespace scidb4gdal {
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
                     << "id=" << sessionID
                     << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0)
-                    << "&save="
-                    << "csv";
+                    << saveParameter("(string null,string null)");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -2001,32 +3046,24 @@ namespace scidb4gdal {
         }
 
 
-        CSVstring* csv;
-        if (!isVersionGreaterThan(15, 7)) {
-            csv = new CSVstring(response, true); // with header
-        } else csv = new CSVstring(response, false); // with header
-
-        if (csv->nrow() == 0) {
+        if (response.empty()) {
             Utils::debug("Array '" + arrayname + "' has no additional metadata, skipping.");
-            delete csv;
             releaseSession(sessionID);
             return SUCCESS;
         }
 
-        if (csv->ncol() != 2) {
-            delete csv;
-            Utils::error("Cannot extract metadata of array '" + arrayname + "'.");
-            releaseSession(sessionID);
-            return ERR_GLOBAL_PARSE;
-        }
-
-        for (int i = 0; i < csv->nrow(); ++i) {
-            string key = csv->get<string>(i, 0).substr(1, csv->get<string>(i, 0).length() - 2);
-            string val = csv->get<string>(i, 1).substr(1, csv->get<string>(i, 1).length() - 2);
-            kv.insert(std::pair<string, string>(key, val));
+        BinaryReader bin(response);
+        while (!bin.eof()) {
+            string key, val;
+            bool keynull, valnull;
+            if (!(bin.readNullFlag(keynull) && bin.readString(key) && bin.readNullFlag(valnull) && bin.readString(val))) {
+                Utils::error("Cannot extract metadata of array '" + arrayname + "'.");
+                releaseSession(sessionID);
+                return ERR_GLOBAL_PARSE;
+            }
+            if (keynull) continue;
+            kv.insert(std::pair<string, string>(key, valnull ? "" : val));
         }
-
-        delete csv;
         releaseSession(sessionID);
 
         return SUCCESS;
@@ -2100,8 +3137,7 @@ namespace scidb4gdal {
             ss << _host << SHIMENDPOINT_EXECUTEQUERY << "?"
                     << "id=" << sessionID
                     << "&query=" << curl_easy_escape(_curl_handle, afl.str().c_str(), 0)
-                    << "&save="
-                    << "csv";
+                    << saveParameter("(string null,string null)");
             // Add auth parameter if using ssl
             if (_ssl && !_auth.empty())
                 ss << "&auth=" << _auth;
@@ -2149,31 +3185,25 @@ namespace scidb4gdal {
         }
 
 
-        CSVstring* csv;
-        if (!isVersionGreaterThan(15, 7)) {
-            csv = new CSVstring(response, true); // with header
-        } else csv = new CSVstring(response, false); // with header
-        if (csv->nrow() == 0) {
+        if (response.empty()) {
             Utils::debug("Array attribute '" + attribute + "' has no additional metadata, skipping.");
-            delete csv;
             releaseSession(sessionID);
             return SUCCESS;
         }
-        if (csv->ncol() != 2) {
-            delete csv;
-            Utils::warn("Cannot extract metadata of array '" + arrayname + "'.");
-            releaseSession(sessionID);
-            return ERR_GLOBAL_PARSE;
-        }
 
-        for (int i = 0; i < csv->nrow(); ++i) {
-            string key = csv->get<string>(i, 0).substr(1, csv->get<string>(i, 0).length() - 2);
-            string val = csv->get<string>(i, 1).substr(1, csv->get<string>(i, 1).length() - 2);
-            kv.insert(std::pair<string, string>(key, val));
+        BinaryReader bin(response);
+        while (!bin.eof()) {
+            string key, val;
+            bool keynull, valnull;
+            if (!(bin.readNullFlag(keynull) && bin.readString(key) && bin.readNullFlag(valnull) && bin.readString(val))) {
+                Utils::error("Cannot extract metadata of attribute '" + arrayname + "." + attribute + "'.");
+                releaseSession(sessionID);
+                return ERR_GLOBAL_PARSE;
+            }
+            if (keynull) continue;
+            kv.insert(std::pair<string, string>(key, valnull ? "" : val));
         }
 
-        delete csv;
-
 
         releaseSession(sessionID);
 
@@ -2181,15 +3211,18 @@ namespace scidb4gdal {
     }
 
     void ShimClient::setCreateParameters(CreationParameters& par) {
-        _cp = &par;
+        delete _cp;
+        _cp = new CreationParameters(par);
     }
 
     void ShimClient::setConnectionParameters(ConnectionParameters& par) {
-        _conp = &par;
+        delete _conp;
+        _conp = new ConnectionParameters(par);
     }
 
     void ShimClient::setQueryParameters(QueryParameters& par) {
-        _qp = &par;
+        delete _qp;
+        _qp = new QueryParameters(par);
     }
 
     StatusCode ShimClient::updateTRS(SciDBTemporalArray& array) {
@@ -2238,8 +3271,7 @@ namespace scidb4gdal {
     _colsep(","),
     _rowsep("\n"),
     _header(false),
-    _cells(NULL),
-    _head(NULL),
+    _processed(false),
     _ncol(-1),
     _nrow(-1) { }
 
@@ -2248,8 +3280,7 @@ namespace scidb4gdal {
     _colsep(","),
     _rowsep("\n"),
     _header(header),
-    _cells(NULL),
-    _head(NULL),
+    _processed(false),
     _ncol(-1),
     _nrow(-1) { }
 
@@ -2258,92 +3289,331 @@ namespace scidb4gdal {
     _colsep(colsep),
     _rowsep(rowsep),
     _header(header),
-    _cells(NULL),
-    _head(NULL),
+    _processed(false),
     _ncol(-1),
     _nrow(-1) { }
 
-    CSVstring::~CSVstring() {
-        if (_cells != NULL) {
-            delete _cells;
-            _cells = NULL;
+    CSVstring::~CSVstring() { }
+
+    const CSVstring::Cell* CSVstring::cell(int row, int col) {
+        if (!_processed) process();
+
+        if (row >= _nrow || row < 0) {
+            Utils::error("Invalid CSV row requested!");
+            return NULL;
         }
-        if (_head != NULL) {
-            delete _head;
-            _head = NULL;
+        if (col >= (int)(_rows[row + 1] - _rows[row]) || col < 0) {
+            Utils::error("Invalid CSV col requested!");
+            return NULL;
         }
+        return &_cells[_rows[row] + col];
     }
 
     template<typename T> T CSVstring::get(int row, int col) {
-        if (_cells == NULL) process();
+        return boost::lexical_cast<T>(get<string>(row, col));
+    }
 
-        if (row >= _cells->size() || row < 0) {
-            Utils::error("Invalid CSV row requested!");
+    template<> string CSVstring::get<string>(int row, int col) {
+        string out;
+        const Cell* c = cell(row, col);
+        if (c == NULL) return out;
+        if (c->escaped) unescape(c, out);
+        else out.assign(_s, c->offset, c->length);
+        return out;
+    }
+
+    template<> bool CSVstring::get<bool>(int row, int col) {
+        const Cell* c = cell(row, col);
+        if (c == NULL) throw boost::bad_lexical_cast();
+        if (c->length == 1 && (_s[c->offset] == '1' || _s[c->offset] == '0')) return _s[c->offset] == '1';
+        if (c->length == 4 && strncasecmp(_s.data() + c->offset, "true", 4) == 0) return true;
+        if (c->length == 5 && strncasecmp(_s.data() + c->offset, "false", 5) == 0) return false;
+        throw boost::bad_lexical_cast();
+    }
+
+    template<> double CSVstring::get<double>(int row, int col) {
+        double out;
+        const Cell* c = cell(row, col);
+        if (c == NULL || !parseDouble(c, out)) throw boost::bad_lexical_cast();
+        return out;
+    }
+
+    template<> int32_t CSVstring::get<int32_t>(int row, int col) {
+        int32_t out;
+        const Cell* c = cell(row, col);
+        if (c == NULL || !parseInteger<int32_t>(c, out)) throw boost::bad_lexical_cast();
+        return out;
+    }
+
+    template<> uint32_t CSVstring::get<uint32_t>(int row, int col) {
+        uint32_t out;
+        const Cell* c = cell(row, col);
+        if (c == NULL || !parseInteger<uint32_t>(c, out)) throw boost::bad_lexical_cast();
+        return out;
+    }
+
+    template<> int64_t CSVstring::get<int64_t>(int row, int col) {
+        int64_t out;
+        const Cell* c = cell(row, col);
+        if (c == NULL || !parseInteger<int64_t>(c, out)) throw boost::bad_lexical_cast();
+        return out;
+    }
+
+    template<> uint64_t CSVstring::get<uint64_t>(int row, int col) {
+        uint64_t out;
+        const Cell* c = cell(row, col);
+        if (c == NULL || !parseInteger<uint64_t>(c, out)) throw boost::bad_lexical_cast();
+        return out;
+    }
+
+    bool CSVstring::equals(int row, int col, const char* s) {
+        const Cell* c = cell(row, col);
+        if (c == NULL) return false;
+        if (c->escaped) {
+            string v;
+            unescape(c, v);
+            return v.compare(s) == 0;
         }
-        if (col >= (*_cells)[row].size() || col < 0) {
-            Utils::error("Invalid CSV col requested!");
+        return _s.compare(c->offset, c->length, s) == 0;
+    }
+
+    template<typename T> bool CSVstring::parseInteger(const Cell* c, T& out) {
+        const char* p = _s.data() + c->offset;
+        const char* e = p + c->length;
+        while (p < e && isspace((unsigned char)*p)) ++p;
+        while (e > p && isspace((unsigned char)*(e - 1))) --e;
+
+        bool neg = false;
+        if (p < e && (*p == '-' || *p == '+')) {
+            neg = (*p == '-');
+            ++p;
+        }
+        if (p == e) return false;
+
+        uint64_t v = 0;
+        for (; p < e; ++p) {
+            if (*p < '0' || *p > '9') return false;
+            uint64_t d = (uint64_t)(*p - '0');
+            if (v > (numeric_limits<uint64_t>::max() - d) / 10) return false; // overflow
+            v = v * 10 + d;
+        }
+
+        if (neg) {
+            if (v == 0) {
+                out = 0;
+                return true;
+            }
+            if (!numeric_limits<T>::is_signed) return false;
+            uint64_t lim = (uint64_t)numeric_limits<T>::max() + 1;
+            if (v > lim) return false;
+            out = (v == lim) ? numeric_limits<T>::min() : -(T)v;
+            return true;
         }
-        return boost::lexical_cast<T>((*_cells)[row][col]);
+        if (v > (uint64_t)numeric_limits<T>::max()) return false;
+        out = (T)v;
+        return true;
+    }
+
+    bool CSVstring::parseDouble(const Cell* c, double& out) {
+        // Numbers are short, copy to a stack buffer to get a null-terminated string for CPLStrtod (locale independent)
+        char buf[64];
+        if (c->length == 0 || c->length >= sizeof(buf)) return false;
+        memcpy(buf, _s.data() + c->offset, c->length);
+        buf[c->length] = '\0';
+        char* end = NULL;
+        out = CPLStrtod(buf, &end);
+        if (end == buf) return false;
+        while (*end != '\0' && isspace((unsigned char)*end)) ++end;
+        return *end == '\0';
+    }
 
+    void CSVstring::unescape(const Cell* c, string& out) {
+        out.clear();
+        out.reserve(c->length);
+        const char* p = _s.data() + c->offset;
+        const char* e = p + c->length;
+        for (; p < e; ++p) {
+            if (*p == '\\' && p + 1 < e) {
+                ++p;
+                switch (*p) {
+                    case 'n': out += '\n';
+                        break;
+                    case 't': out += '\t';
+                        break;
+                    case 'r': out += '\r';
+                        break;
+                    default: out += *p; // \\, \', escaped separators
+                }
+            } else out += *p;
+        }
     }
 
     int CSVstring::ncol() {
-        if (_cells == NULL) process();
+        if (!_processed) process();
         return _ncol;
     }
 
     int CSVstring::nrow() {
-        if (_cells == NULL) process();
+        if (!_processed) process();
         return _nrow;
     }
 
     void CSVstring::process() {
-        if (_cells != NULL) {
-            delete _cells;
-            _cells = NULL;
-        }
+        _cells.clear();
+        _rows.clear();
         _nrow = 0;
         _ncol = 0;
-        _cells = new vector<vector<string> >;
 
+        const size_t n = _s.length();
+        size_t pos = 0;
+        bool skipHeader = _header;
+        int line = 0;
 
-        vector<string> rows = Utils::split(_s, _rowsep);
+        while (pos < n) {
+            ++line;
 
+            // Empty row
+            if (_s.compare(pos, _rowsep.length(), _rowsep) == 0) {
+                pos += _rowsep.length();
+                continue;
+            }
 
-        size_t i = 0;
-        if (_header) {
-            while (rows[i].empty() && i < rows.size()) ++i;
-            vector <string> cols = Utils::split(rows[i], _colsep);
-            _head = new vector<string>(cols);
-            ++i;
-        }
+            size_t rowStart = _cells.size();
+            bool endOfRow = false;
+            while (!endOfRow) {
+                Cell c;
+                c.escaped = false;
+
+                if (pos < n && _s[pos] == '\'') {
+                    // Quoted value, ends at the next unescaped quote
+                    c.offset = ++pos;
+                    while (pos < n && _s[pos] != '\'') {
+                        if (_s[pos] == '\\') {
+                            c.escaped = true;
+                            ++pos;
+                        }
+                        ++pos;
+                    }
+                    c.length = min(pos, n) - c.offset;
+                    if (pos < n) ++pos; // closing quote
+                    // Ignore anything until the next separator
+                    while (pos < n && _s.compare(pos, _colsep.length(), _colsep) != 0 && _s.compare(pos, _rowsep.length(), _rowsep) != 0) ++pos;
+                } else {
+                    c.offset = pos;
+                    while (pos < n && _s.compare(pos, _colsep.length(), _colsep) != 0 && _s.compare(pos, _rowsep.length(), _rowsep) != 0) {
+                        if (_s[pos] == '\\') {
+                            c.escaped = true;
+                            ++pos;
+                        }
+                        ++pos;
+                    }
+                    c.length = min(pos, n) - c.offset;
+                    if (c.length > 0 && _s[c.offset + c.length - 1] == '\r') --c.length; // CRLF line endings
+                }
+                _cells.push_back(c);
 
+                if (pos < n && _s.compare(pos, _colsep.length(), _colsep) == 0) {
+                    pos += _colsep.length();
+                } else {
+                    if (pos < n) pos += _rowsep.length();
+                    endOfRow = true;
+                }
+            }
 
-        while (i < rows.size()) {
-            if (rows[i].empty()) {
-                ++i;
+            if (skipHeader) {
+                _cells.resize(rowStart);
+                skipHeader = false;
                 continue;
             }
 
-            vector <string> cols = Utils::split(rows[i], _colsep);
-            if (_ncol <= 0) _ncol = cols.size();
-            if (_ncol != cols.size()) {
+            int ncols = (int)(_cells.size() - rowStart);
+            if (_ncol <= 0) _ncol = ncols;
+            if (_ncol != ncols) {
                 stringstream ss;
-                ss << "Unexpected number of colums in CSV string at line  " << i + 1 << ": expected " << _ncol << " but had " << cols.size();
+                ss << "Unexpected number of colums in CSV string at line  " << line << ": expected " << _ncol << " but had " << ncols;
                 Utils::warn(ss.str());
+                if (ncols > _ncol) _ncol = ncols;
             }
 
+            _rows.push_back(rowStart);
             ++_nrow;
-            _cells->push_back(cols);
-            ++i;
         }
+        _rows.push_back(_cells.size());
+        _processed = true;
+    }
+
+    /****************************************************************************************** */
+
+    BinaryReader::BinaryReader(const string& s) :
+    _s(s),
+    _pos(0),
+    _fail(false) { }
+
+    BinaryReader::~BinaryReader() { }
+
+    template<typename T> bool BinaryReader::readFixed(T& out) {
+        if (_fail || _pos + sizeof(T) > _s.length()) {
+            _fail = true;
+            return false;
+        }
+        memcpy(&out, _s.data() + _pos, sizeof(T));
+        _pos += sizeof(T);
+        return true;
+    }
+
+    bool BinaryReader::readNullFlag(bool& isnull) {
+        int8_t flag;
+        if (!readFixed<int8_t>(flag)) return false;
+        isnull = (flag != -1);
+        return true;
+    }
+
+    bool BinaryReader::readBool(bool& out) {
+        uint8_t v;
+        if (!readFixed<uint8_t>(v)) return false;
+        out = (v != 0);
+        return true;
+    }
+
+    bool BinaryReader::readInt32(int32_t& out) {
+        return readFixed<int32_t>(out);
     }
 
+    bool BinaryReader::readUInt32(uint32_t& out) {
+        return readFixed<uint32_t>(out);
+    }
 
+    bool BinaryReader::readInt64(int64_t& out) {
+        return readFixed<int64_t>(out);
+    }
 
+    bool BinaryReader::readUInt64(uint64_t& out) {
+        return readFixed<uint64_t>(out);
+    }
 
+    bool BinaryReader::readDouble(double& out) {
+        return readFixed<double>(out);
+    }
 
+    bool BinaryReader::readString(string& out) {
+        uint32_t len;
+        if (!readFixed<uint32_t>(len)) return false;
+        if (_pos + len > _s.length()) {
+            _fail = true;
+            return false;
+        }
+        // length includes the terminating null character
+        out.assign(_s, _pos, (len > 0 && _s[_pos + len - 1] == '\0') ? len - 1 : len);
+        _pos += len;
+        return true;
+    }
 
+    bool BinaryReader::eof() const {
+        return _pos >= _s.length();
+    }
 
+    bool BinaryReader::fail() const {
+        return _fail;
+    }
 
 }
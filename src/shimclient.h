@@ -39,6 +39,7 @@ SOFTWARE.
 
 #include "affinetransform.h"
 #include "utils.h"
+#include "cpl_multiproc.h"
 
 
 #define SHIMENDPOINT_NEW_SESSION "/new_session"
@@ -51,6 +52,8 @@ SOFTWARE.
 #define SHIMENDPOINT_UPLOAD_FILE "/upload_file"
 #define SHIMENDPOINT_VERSION "/version"
 
+#define SHIM_MAX_TIMESERIES_POINTS 256 // number of locations per time series query, limits the length of the query URL
+
 #define CURL_RETRIES 3
 //#define CURL_VERBOSE  // Uncomment this line if you want to debug CURL
 // requests and responses
@@ -146,6 +149,14 @@ namespace scidb4gdal
          */
         ShimClient(ConnectionParameters* con);
 
+        /**
+         * @brief Copy constructor
+         *
+         * Creates a new SHIM client connecting to the same server with the same parameters. The copy does not share the
+         * cURL handle or the authentication token of the original client and can hence be used independently.
+         */
+        ShimClient(const ShimClient& other);
+
         /**
          * Default destructor f Shim clients.
          */
@@ -178,26 +189,143 @@ namespace scidb4gdal
          * @param ymin lower boundary, we assume y to be "northing" which is different from GDAL!
          * @param xmax right boundary, we assume x to be "easting" which is different from GDAL!
          * @param ymax upper boundary, we assume y to be "northing" which is different from GDAL!
-         * @param use_subarray whether or not subarrays are used.
-         * @param emptycheck a boolean to state whether or not to check for empty cells
+         * @param strategy operator that cuts the block out of the array. With READ_AUTO, the opening option read_strategy applies, which defaults to
+         * choosing per block: dense blocks that do not coincide with a chunk always use subarray(), otherwise the faster operator is learned from the
+         * latencies of previous blocks of the array.
+         * @param emptycheck a boolean to state whether or not to check for empty cells. If set, empty cells are filled with the no data value of
+         * the attribute client-side. Blocks are fetched as values only if the previous block of the array had no empty cells (see the opening
+         * option dense_threshold), otherwise or if the block turns out to have empty cells, only non-empty cells are fetched together with their
+         * position. If not set, the block must not have empty cells.
+         * @param mask if not NULL, gets one byte per cell that is 255 for non-empty and 0 for empty cells, in the same order as outchunk
          * @return scidb4gdal::StatusCode
          */
         StatusCode getData(SciDBSpatialArray& array, uint8_t nband, void* outchunk,
                            int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max,
-                           bool use_subarray = true, bool emptycheck = true);
+                           ReadStrategy strategy = READ_AUTO, bool emptycheck = true, uint8_t* mask = NULL);
+
+        /**
+         * @brief Retreives single attribute data of a spatial or spatio-temporal hyperslab with one query
+         *
+         * In contrast to getData(), the requested box may span several chunks and several time slices. Each returned cell carries its
+         * linear position within the box, which is computed in SciDB, such that the result can be streamed into the output buffer
+         * independently of chunk order and dimension order of the array. Empty cells are filled with the no data value of the attribute.
+         *
+         * @param array metadata of an existing array
+         * @param nband index of the requested attribute (starting with 0).
+         * @param out output buffer for (t_max - t_min + 1) * (y_max - y_min + 1) * (x_max - x_min + 1) values of the attribute type, in row major (t,y,x) order
+         * @param x_min lower x index
+         * @param y_min lower y index
+         * @param x_max upper x index
+         * @param y_max upper y index
+         * @param t_min lower temporal index, ignored for arrays without temporal dimension
+         * @param t_max upper temporal index, ignored for arrays without temporal dimension
+         * @param mask if not NULL, gets one byte per cell that is 255 for non-empty and 0 for empty cells, in the same order as out
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getHyperslab(SciDBSpatialArray& array, uint8_t nband, void* out,
+                                int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max,
+                                int64_t t_min = 0, int64_t t_max = 0, uint8_t* mask = NULL);
+
+        /**
+         * @brief Retreives several attributes of a spatial or spatio-temporal hyperslab with one query
+         *
+         * @see getHyperslab(SciDBSpatialArray&, uint8_t, void*, int64_t, int64_t, int64_t, int64_t, int64_t, int64_t)
+         * @param array metadata of an existing array
+         * @param bands indexes of the requested attributes (starting with 0)
+         * @param out one output buffer per requested attribute, each in row major (t,y,x) order
+         * @param x_min lower x index
+         * @param y_min lower y index
+         * @param x_max upper x index
+         * @param y_max upper y index
+         * @param t_min lower temporal index, ignored for arrays without temporal dimension
+         * @param t_max upper temporal index, ignored for arrays without temporal dimension
+         * @param mask if not NULL, gets one byte per cell that is 255 for non-empty and 0 for empty cells, null values do not affect the mask
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getHyperslab(SciDBSpatialArray& array, const vector<uint8_t>& bands, const vector<void*>& out,
+                                int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max,
+                                int64_t t_min = 0, int64_t t_max = 0, uint8_t* mask = NULL);
 
         /**
-         * @brief Fetches the band statistics of the data from the SciDB database
+         * @brief Retreives the time series of a single attribute at a list of pixel locations
          *
-         * Gets simple band statistics using in-database aggregation functions
+         * All locations are requested with one query that filters the cells of the spatial bounding box of the locations. Large lists are split
+         * into batches of SHIM_MAX_TIMESERIES_POINTS locations. Empty cells are filled with the no data value of the attribute.
+         *
+         * @param array metadata of an existing array
+         * @param nband index of the requested attribute (starting with 0).
+         * @param xs x indexes of the locations
+         * @param ys y indexes of the locations, same length as xs
+         * @param out output buffer for xs.size() * (t_max - t_min + 1) values of the attribute type, one complete time series per location
+         * @param t_min lower temporal index, ignored for arrays without temporal dimension
+         * @param t_max upper temporal index, ignored for arrays without temporal dimension
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getTimeSeries(SciDBSpatialArray& array, uint8_t nband, const vector<int64_t>& xs, const vector<int64_t>& ys,
+                                 void* out, int64_t t_min = 0, int64_t t_max = 0);
+
+        /**
+         * @brief Computes temporal reductions of a single attribute over a spatial box in SciDB
+         *
+         * The attribute is aggregated along the temporal dimension with aggregate() grouped by the spatial dimensions, such that only
+         * the reduced two-dimensional result is transferred. Null and no data values are ignored. Cells without any valid value are
+         * NaN, or 0 for "count".
+         *
+         * @param array metadata of an existing spatio-temporal array
+         * @param nband index of the requested attribute (starting with 0).
+         * @param ops reductions to compute, each one of "mean", "min", "max" or "count"
+         * @param out one output buffer per reduction for (y_max - y_min + 1) * (x_max - x_min + 1) doubles in row major (y,x) order
+         * @param x_min lower x index
+         * @param y_min lower y index
+         * @param x_max upper x index
+         * @param y_max upper y index
+         * @param t_min lower temporal index
+         * @param t_max upper temporal index
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getTemporalReduction(SciDBSpatioTemporalArray& array, uint8_t nband, const vector<string>& ops, const vector<double*>& out,
+                                        int64_t x_min, int64_t y_min, int64_t x_max, int64_t y_max, int64_t t_min, int64_t t_max);
+
+        /**
+         * @brief Fetches the statistics of all bands with one aggregate query
+         *
+         * Cells equal to the NODATA value of a band are ignored for that band only. Statistics of bands without any
+         * valid cell are NaN.
+         *
+         * @param array metadata of an existing array
+         * @param out result statistics, one per attribute
+         * @param sample fraction of cells in (0,1] that are sampled by bernoulli(), 1 for exact statistics
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getAttributeStats(SciDBSpatialArray& array, vector<SciDBAttributeStats>& out, double sample = 1);
+
+        /**
+         * @brief Fetches the statistics of all bands of a range of temporal slices with one aggregate query
+         *
+         * @param array metadata of an existing spatio-temporal array
+         * @param t_min lower temporal index
+         * @param t_max upper temporal index
+         * @param out result statistics, one vector of per attribute statistics per temporal index starting with t_min
+         * @param sample fraction of cells in (0,1] that are sampled by bernoulli(), 1 for exact statistics
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getAttributeStats(SciDBSpatioTemporalArray& array, int64_t t_min, int64_t t_max,
+                                     vector<vector<SciDBAttributeStats> >& out, double sample = 1);
+
+        /**
+         * @brief Computes a histogram of a band in SciDB
+         *
+         * Values are assigned to buckets by an apply() expression and counted per bucket by redimension(), only the counts
+         * are transferred. Bucket limits follow GDALRasterBand::GetHistogram(). Cells equal to the NODATA value are ignored.
          *
          * @param array metadata of an existing array
          * @param nband band index, 0 based
-         * @param out result statistics, i.e. min, max, mean, sd
+         * @param hist the histogram, min, max, includeOutOfRange and the size of counts define the buckets, counts are overwritten
+         * @param sample fraction of cells in (0,1] that are sampled by bernoulli(), 1 for exact counts
+         * @param t temporal index of the slice of a spatio-temporal array, -1 for all cells
          * @return scidb4gdal::StatusCode
          */
-        StatusCode getAttributeStats(SciDBSpatialArray& array, uint8_t nband,
-                                     SciDBAttributeStats& out);
+        StatusCode getAttributeHistogram(SciDBSpatialArray& array, uint8_t nband, SciDBHistogram& hist, double sample = 1, int64_t t = -1);
 
         /**
          * @brief intializes the cURL easy interface
@@ -226,6 +354,26 @@ namespace scidb4gdal
          */
         CURLcode curlPerform();
 
+        /**
+         * @brief Performs a cURL request and checks the response status
+         *
+         * Shim reports failed queries with an HTTP error status and possibly an empty body, which must not be taken for
+         * an empty result.
+         *
+         * @return true if the request succeeded with HTTP status 200
+         */
+        bool curlPerformSucceeded();
+
+        /**
+         * @brief Builds the save URL parameter of a shim query
+         *
+         * Save formats may contain blanks, e.g. "(int32 null)", and must be URL-escaped. Requires curlBegin().
+         *
+         * @param format shim save format, e.g. "csv" or "(double,int64)"
+         * @return "&save=" followed by the escaped format
+         */
+        string saveParameter(const string& format);
+
         /**
          * @brief Checks the cURL connection
          *
@@ -268,6 +416,17 @@ namespace scidb4gdal
          */
         StatusCode persistArray(string srcArr, string tarArr);
 
+        /**
+         * @brief Inserts all cells of an array into another array with identical schema
+         *
+         * This function applies the 'insert' command, which creates exactly one new version of the target array.
+         *
+         * @param srcArr array name of the source array
+         * @param tarArr array name of the target array
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode appendArray(string srcArr, string tarArr);
+
         /**
          * @brief Inserts a chunk of data to an existing array
          *
@@ -289,6 +448,25 @@ namespace scidb4gdal
         StatusCode insertData(SciDBSpatialArray& array, void* inChunk, int32_t x_min,
                               int32_t y_min, int32_t x_max, int32_t y_max);
 
+        /**
+         * @brief Uploads a chunk of data into a single temporal slice of a spatiotemporal array
+         *
+         * In contrast to insertData() followed by insertInto(), no coordinates are derived on the server (eo_over). The tile
+         * boundaries and the temporal index are already given in coordinates of the array, the cells are filtered by the NODATA
+         * values of the attributes and inserted into array.name with a single redimension to the schema of the array.
+         *
+         * @param array metadata representation of the array, attributes carry the NODATA values of the image
+         * @param inChunk pointer to a chunk of memory that holds data in scidb binary format
+         * @param t index of the temporal slice
+         * @param x_min left boundary in array coordinates
+         * @param y_min lower boundary in array coordinates
+         * @param x_max right boundary in array coordinates
+         * @param y_max upper boundary in array coordinates
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode insertSlice(SciDBSpatioTemporalArray& array, void* inChunk, int64_t t, int32_t x_min,
+                               int32_t y_min, int32_t x_max, int32_t y_max);
+
         /**
          * @brief Inserts an array in SciDB into another one if they are compatible
          *
@@ -334,6 +512,18 @@ namespace scidb4gdal
          */
         StatusCode arrayExists(const string& inArrayName, bool& out);
 
+        /**
+         * @brief Gets a token that changes with every new version of an array
+         *
+         * The token consists of the latest version id of the array and its timestamp, such that it also changes if the array is removed
+         * and created again. Data that has been read from the array can be reused as long as the token does not change.
+         *
+         * @param inArrayName input array name string
+         * @param out output, the token, "0" for arrays without any version
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode getArrayVersion(const string& inArrayName, string& out);
+
         /**
          * @brief Adds metadata on an array in SciDB
          *
@@ -394,7 +584,7 @@ namespace scidb4gdal
          *
          * This function sets the create parameter obtained from the create options or the properties string to SHIM client.
          *
-         * @param par The create parameters
+         * @param par The create parameters, will be copied
          * @return Void.
          */
         void setCreateParameters(CreationParameters& par);
@@ -405,7 +595,7 @@ namespace scidb4gdal
          * This function sets the connection parameter obtained from the create or opening options or the connection file string. The connection
          * parameter will be used to authenticate at the specified SHIM web client.
          *
-         * @param par the ConnectionParameters
+         * @param par the ConnectionParameters, will be copied
          * @return Void.
          */
         void setConnectionParameters(ConnectionParameters& par);
@@ -415,7 +605,7 @@ namespace scidb4gdal
          *
          * Sets the query parameter obtained from the opening options or the filename string.
          *
-         * @param par The @see QueryParameters
+         * @param par The @see QueryParameters, will be copied. Later changes to par are not seen by the client.
          * @return Void.
          */
         void setQueryParameters(QueryParameters& par);
@@ -446,6 +636,19 @@ namespace scidb4gdal
         StatusCode getType(const string& name, SciDBSpatialArray*& array);
 
     protected:
+        /**
+         * @brief Computes the statistics of all attributes with one aggregate query, optionally per temporal slice
+         *
+         * @param array metadata of an existing array
+         * @param t_min lower temporal index, -1 for statistics over all cells
+         * @param t_max upper temporal index
+         * @param out result statistics, one vector of per attribute statistics per temporal index, or a single vector
+         * @param sample fraction of cells in (0,1] that are sampled by bernoulli(), 1 for exact statistics
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode computeAttributeStats(SciDBSpatialArray& array, int64_t t_min, int64_t t_max,
+                                         vector<vector<SciDBAttributeStats> >& out, double sample);
+
         /**
          * @brief Fetches all attribute metadata of an array in SciDB
          *
@@ -568,11 +771,92 @@ namespace scidb4gdal
          */
         void logout();
 
+        /**
+         * @brief Executes a data query of getData() for a given band and block
+         *
+         * @param array metadata of an existing array
+         * @param nband index of the requested attribute (starting with 0)
+         * @param arr name of the array or slice expression the data is read from
+         * @param outchunk output buffer for the block
+         * @param x_min left boundary
+         * @param y_min lower boundary
+         * @param x_max right boundary
+         * @param y_max upper boundary
+         * @param strategy operator that cuts the block out of the array, see useSubarray()
+         * @param sparse fetch non-empty cells with their position instead of values only
+         * @param mask if not NULL, gets one byte per cell that is 255 for non-empty and 0 for empty cells, null values do not affect the mask
+         * @param ncells [out] number of non-empty cells of the block. If values only are fetched and this is less than the number of cells of
+         * the block, outchunk and mask are undefined.
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode readBlock(SciDBSpatialArray& array, uint8_t nband, const string& arr, void* outchunk,
+                             int32_t x_min, int32_t y_min, int32_t x_max, int32_t y_max, ReadStrategy strategy, bool sparse,
+                             uint8_t* mask, size_t& ncells);
+
+        /**
+         * @brief Decides whether a block is cut out with subarray() or with between()
+         *
+         * If not forced, both operators are tried on the first blocks of an array, starting with between() for blocks that coincide with a
+         * chunk and with subarray() otherwise. Then the operator with the lower latency is used, the other one is measured again from time to time.
+         * Latencies are tracked separately for aligned and unaligned blocks.
+         *
+         * @param arr name of the array or slice expression the data is read from
+         * @param strategy forced operator, or READ_AUTO
+         * @param aligned whether the block coincides with a chunk of the array
+         * @param sparse whether cells are fetched with their position
+         * @return true for subarray(), false for between()
+         */
+        bool useSubarray(const string& arr, ReadStrategy strategy, bool aligned, bool sparse);
+
+        /**
+         * @brief Records the latency of a block read, see useSubarray()
+         */
+        void recordLatency(const string& arr, bool aligned, bool use_subarray, double secondsPerCell);
+
+        /**
+         * @brief Prepares the data query of getData() for a given band
+         *
+         * Builds the AFL query to fetch a block of a band with placeholders for the block boundaries and URL-escapes
+         * all literal parts. The result depends only on the array or slice expression, the name, type and nullability
+         * of the attribute, the spatial dimensions and the query options, see AFLQueryTemplateKey, so it can be reused for all blocks.
+         *
+         * @param array metadata of an existing array
+         * @param nband index of the requested attribute (starting with 0)
+         * @param arr name of the array or slice expression the data is read from
+         * @param use_subarray whether or not subarrays are used
+         * @param sparse whether or not only non-empty cells are fetched together with their position in the block
+         * @return prepared query, including the save format but not the authentication URL parameter
+         */
+        AFLQueryTemplate prepareDataQuery(SciDBSpatialArray& array, uint8_t nband, const string& arr,
+                                          bool use_subarray, bool sparse);
+
+        /**
+         * @brief Uploads a chunk of memory as file to the shim server
+         *
+         * @param sessionID shim session the file belongs to
+         * @param data pointer to the data
+         * @param totalSize number of bytes to upload
+         * @param remoteFilename [out] name of the uploaded file on the server
+         * @return scidb4gdal::StatusCode
+         */
+        StatusCode uploadFile(int sessionID, void* data, size_t totalSize, string& remoteFilename);
+
+        /**
+         * @brief Wraps an AFL expression in a filter that drops cells equal to the NODATA values of the attributes
+         *
+         * @param array array whose attributes carry the NODATA values
+         * @param afl AFL expression with the attributes of array
+         * @return the filtered expression, or afl if no NODATA value is set
+         */
+        string filterNoData(SciDBArray& array, const string& afl);
 
 
 
 
     private:
+        /** clients are copied only by means of the copy constructor */
+        ShimClient& operator=(const ShimClient& other);
+
         /** host url */
         string _host;
         /** port number */
@@ -591,20 +875,36 @@ namespace scidb4gdal
         bool _curl_initialized;
         /** authentication string after login */
         string _auth;
-        /** pointer to the connection parameters */
+        /** own copy of the connection parameters */
         ConnectionParameters* _conp;
-        /** pointer to the creation parameters */
+        /** own copy of the creation parameters */
         CreationParameters* _cp;
-        /** pointer to the query parameter */
+        /** own copy of the query parameter */
         QueryParameters* _qp;
         /** is scidb4geo installed? */
         bool* _hasSCIDB4GEO;
         /** version of Shim */
         string _shimversion;
+        /** guards _dataQueryTemplates, _blockDensity and _readLatency */
+        CPLMutex* _hReadMutex;
+        /** prepared data queries of getData(), keyed by everything they embed */
+        map<AFLQueryTemplateKey, AFLQueryTemplate> _dataQueryTemplates;
+        /** fraction of non-empty cells of the previously read block by array or slice expression, see getData() */
+        map<string, double> _blockDensity;
+        /** measured latencies of block reads by array or slice expression and alignment with chunks, see useSubarray() */
+        map<pair<string, bool>, ReadLatency> _readLatency;
     };
 
     /**
-     * @brief A very simple class to interpret CSV strings as tables
+     * @brief Lightweight parser for CSV formatted shim responses
+     *
+     * The response is tokenized in a single pass. Cells are stored as spans (offset and length) into the
+     * original string, no per-row or per-cell strings are allocated. SciDB quotes string values with single quotes
+     * and escapes quotes, separators, and backslashes inside quoted values with a backslash. Quotes are removed from
+     * the spans directly, escape sequences are only resolved if a string value is actually requested.
+     * Numeric values are parsed directly from the spans without intermediate strings.
+     *
+     * The response string is referenced, not copied, and must outlive the CSVstring object.
      */
     class CSVstring
     {
@@ -638,13 +938,24 @@ namespace scidb4gdal
         ~CSVstring();
 
         /**
-         * Returns a cell value as a given type.
+         * Returns a cell value as a given type. Quotes around string values are removed and escape sequences are resolved.
+         * Numeric types are parsed directly from the response buffer, a boost::bad_lexical_cast exception is thrown if
+         * the cell cannot be converted.
          * @param row zero-based row index ignoring empty and header rows
          * @param col zero-based column index
-         * @return the converted value of the cell, using string is safest
+         * @return the converted value of the cell
          */
         template<typename T> T get(int row, int col);
 
+        /**
+         * Compares the unquoted content of a cell with a given string without copying the cell
+         * @param row zero-based row index ignoring empty and header rows
+         * @param col zero-based column index
+         * @param s null-terminated string to compare with
+         * @return true if the cell content equals s
+         */
+        bool equals(int row, int col, const char* s);
+
         /**
          * Returns the number of rows. Header and empty rows are ignored.
          * @return number of rows as integer
@@ -660,22 +971,112 @@ namespace scidb4gdal
 
     private:
 
+        /**
+         * @brief A cell as a span into the response string
+         */
+        struct Cell {
+            size_t offset;
+            size_t length;
+            bool escaped; // true if the span contains backslash escape sequences
+        };
 
         void process();
 
-        const string _s;
+        const Cell* cell(int row, int col);
+
+        template<typename T> bool parseInteger(const Cell* c, T& out);
+        bool parseDouble(const Cell* c, double& out);
+        void unescape(const Cell* c, string& out);
+
+        const string& _s;
 
         const string _colsep;
         const string _rowsep;
         const bool _header;
 
-        vector<vector<string> >* _cells;
-        vector<string>* _head;
+        bool _processed;
+        vector<Cell> _cells; // all cells of all rows
+        vector<size_t> _rows; // index of the first cell of each row in _cells, plus end marker
 
         int _ncol;
         int _nrow;
 
     };
+
+    template<> string CSVstring::get<string>(int row, int col);
+    template<> bool CSVstring::get<bool>(int row, int col);
+    template<> double CSVstring::get<double>(int row, int col);
+    template<> int32_t CSVstring::get<int32_t>(int row, int col);
+    template<> uint32_t CSVstring::get<uint32_t>(int row, int col);
+    template<> int64_t CSVstring::get<int64_t>(int row, int col);
+    template<> uint64_t CSVstring::get<uint64_t>(int row, int col);
+
+    /**
+     * @brief Sequential reader for binary formatted shim responses
+     *
+     * Decodes the output of queries saved with a SciDB binary format template like "(string,int64,bool)". Values are
+     * stored cell by cell and attribute by attribute. Fixed width types are stored in native byte order as in the data
+     * path of getData(), strings are prefixed with a 4 byte length including the terminating null character, and
+     * nullable values are prefixed with a single byte that is -1 if the value is present. Values must be read in the
+     * order of the format template. A read past the end of the response sets the fail flag instead of throwing.
+     *
+     * The response string is referenced, not copied, and must outlive the BinaryReader object.
+     */
+    class BinaryReader
+    {
+    public:
+
+        /**
+         * Constructor
+         * @param s binary response of a shim query
+         */
+        BinaryReader(const string & s);
+
+        /**
+         * Default desctructor
+         */
+        ~BinaryReader();
+
+        /**
+         * Reads the null indicator of a nullable value
+         * @param isnull set to true if the following value is missing
+         * @return false if reading failed
+         */
+        bool readNullFlag(bool& isnull);
+
+        /**
+         * Read the next value of the given type
+         * @param out value
+         * @return false if reading failed
+         */
+        bool readBool(bool& out);
+        bool readInt32(int32_t& out);
+        bool readUInt32(uint32_t& out);
+        bool readInt64(int64_t& out);
+        bool readUInt64(uint64_t& out);
+        bool readDouble(double& out);
+        bool readString(string& out);
+
+        /**
+         * Checks whether all bytes of the response have been consumed
+         * @return true if nothing left to read
+         */
+        bool eof() const;
+
+        /**
+         * Checks whether any read operation failed so far
+         * @return true if a previous read failed
+         */
+        bool fail() const;
+
+    private:
+
+        template<typename T> bool readFixed(T& out);
+
+        const string& _s;
+        size_t _pos;
+        bool _fail;
+    };
 }
 
 #endif
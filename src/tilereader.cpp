@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#include "tilereader.h"
+#include <stdlib.h>
+
+namespace scidb4gdal {
+
+    TileReader::TileReader(SciDBSpatioTemporalArray& slice)
+        : _pixelSize(0), _stop(false), _hMutex(NULL), _hCond(CPLCreateCond()), _hThread(NULL) {
+        for (uint32_t i = 0; i < slice.attrs.size(); ++i) {
+            _types.push_back(slice.attrs[i].type);
+            _pixelSize += slice.attrs[i].type.bytes;
+        }
+        SciDBDimension* xdim = slice.getXDim();
+        SciDBDimension* ydim = slice.getYDim();
+        _xstart = xdim->start;
+        _ystart = ydim->start;
+        _xcs = (xdim->chunksize > 0) ? xdim->chunksize : 1;
+        _ycs = (ydim->chunksize > 0) ? ydim->chunksize : 1;
+    }
+
+    TileReader::~TileReader() {
+        {
+            CPLMutexHolderD(&_hMutex);
+            _stop = true;
+            CPLCondBroadcast(_hCond);
+        }
+        if (_hThread != NULL) CPLJoinThread(_hThread);
+        for (size_t i = 0; i < _tiles.size(); ++i) free(_tiles[i].data);
+        CPLDestroyCond(_hCond);
+        if (_hMutex != NULL) CPLDestroyMutex(_hMutex);
+    }
+
+    void TileReader::add(GDALDataset* poSrcDS, int64_t x0, int64_t y0) {
+        Job job;
+        job.poSrcDS = poSrcDS;
+        job.x0 = x0;
+        job.y0 = y0;
+        CPLMutexHolderD(&_hMutex);
+        _jobs.push_back(job);
+        CPLCondBroadcast(_hCond);
+        if (_hThread == NULL) _hThread = CPLCreateJoinableThread(run, this);
+    }
+
+    bool TileReader::next(ImageTile& tile) {
+        CPLMutexHolderD(&_hMutex);
+        if (_hThread == NULL) {
+            Utils::error("Cannot start the thread reading images for the upload");
+            tile = ImageTile();
+            tile.failed = true;
+            return false;
+        }
+        while (_tiles.empty()) CPLCondWait(_hCond, _hMutex);
+        tile = _tiles.front();
+        _tiles.pop_front();
+        CPLCondBroadcast(_hCond);
+        return tile.data != NULL;
+    }
+
+    void TileReader::run(void* reader) {
+        TileReader* r = (TileReader*)reader;
+        while (true) {
+            Job job;
+            {
+                CPLMutexHolderD(&r->_hMutex);
+                while (r->_jobs.empty() && !r->_stop) CPLCondWait(r->_hCond, r->_hMutex);
+                if (r->_stop) return;
+                job = r->_jobs.front();
+                r->_jobs.pop_front();
+            }
+            if (!r->read(job)) return;
+        }
+    }
+
+    bool TileReader::read(const Job& job) {
+        const int64_t x1 = job.x0 + job.poSrcDS->GetRasterXSize() - 1;
+        const int64_t y1 = job.y0 + job.poSrcDS->GetRasterYSize() - 1;
+
+        ImageTile end;
+        end.nTiles = (Utils::floorDiv(x1 - _xstart, _xcs) - Utils::floorDiv(job.x0 - _xstart, _xcs) + 1) *
+                     (Utils::floorDiv(y1 - _ystart, _ycs) - Utils::floorDiv(job.y0 - _ystart, _ycs) + 1);
+        int64_t iTile = 0;
+        for (int64_t ymin = job.y0; ymin <= y1; ) {
+            int64_t ymax = _ystart + (Utils::floorDiv(ymin - _ystart, _ycs) + 1) * _ycs - 1;
+            if (ymax > y1) ymax = y1;
+            for (int64_t xmin = job.x0; xmin <= x1; ++iTile) {
+                int64_t xmax = _xstart + (Utils::floorDiv(xmin - _xstart, _xcs) + 1) * _xcs - 1;
+                if (xmax > x1) xmax = x1;
+
+                ImageTile tile;
+                tile.xmin = xmin;
+                tile.ymin = ymin;
+                tile.xmax = xmax;
+                tile.ymax = ymax;
+                tile.iTile = iTile;
+                tile.nTiles = end.nTiles;
+                const int nx = (int)(1 + xmax - xmin);
+                const int ny = (int)(1 + ymax - ymin);
+                const size_t nCells = (size_t)nx * (size_t)ny;
+                tile.data = (uint8_t*)malloc(_pixelSize * nCells);
+                bool ok = tile.data != NULL;
+                size_t bandOffset = 0;
+                for (uint16_t iBand = 0; ok && iBand < _types.size(); ++iBand) {
+                    void* blockBandBuf = malloc(nCells * _types[iBand].bytes);
+                    GDALRasterBand* poBand = job.poSrcDS->GetRasterBand(iBand + 1);
+                    ok = blockBandBuf != NULL &&
+                         poBand->RasterIO(GF_Read, (int)(xmin - job.x0), (int)(ymin - job.y0), nx, ny,
+                                          blockBandBuf, nx, ny, _types[iBand].gdalType, 0, 0, NULL) == CE_None;
+                    if (ok) Utils::interleaveBand(_types[iBand].bytes, tile.data, (uint8_t*)blockBandBuf, nCells, _pixelSize, bandOffset);
+                    free(blockBandBuf);
+                    bandOffset += _types[iBand].bytes;
+                }
+                if (!ok) {
+                    free(tile.data);
+                    end.failed = true;
+                    return push(end);
+                }
+                if (!push(tile)) {
+                    free(tile.data);
+                    return false;
+                }
+                xmin = xmax + 1;
+            }
+            ymin = ymax + 1;
+        }
+        return push(end);
+    }
+
+    bool TileReader::push(const ImageTile& tile) {
+        CPLMutexHolderD(&_hMutex);
+        while (_tiles.size() >= SCIDB4GDAL_INGEST_QUEUE && !_stop) CPLCondWait(_hCond, _hMutex);
+        if (_stop) return false;
+        _tiles.push_back(tile);
+        CPLCondBroadcast(_hCond);
+        return true;
+    }
+}
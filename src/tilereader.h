@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2016 Marius Appel <marius.appel@uni-muenster.de>
+
+This file is part of scidb4gdal. scidb4gdal is licensed under the MIT license.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+-----------------------------------------------------------------------------*/
+
+#ifndef TILEREADER_H
+#define TILEREADER_H
+
+#include <deque>
+#include <vector>
+#include <inttypes.h>
+#include "gdal_priv.h"
+#include "cpl_multiproc.h"
+#include "scidb_structs.h"
+
+#define SCIDB4GDAL_INGEST_QUEUE 4 // number of tiles read ahead of the upload during ingestion
+
+namespace scidb4gdal {
+    using namespace std;
+
+    /**
+    * @brief A tile of an image read for the upload into a temporal slice, with interleaved bands
+    */
+    struct ImageTile {
+        /** interleaved cell values, allocated with malloc(), NULL marks the end of an image */
+        uint8_t* data;
+        /** target coordinates of the tile */
+        int64_t xmin, ymin, xmax, ymax;
+        /** index of the tile within its image and number of tiles of the image */
+        int64_t iTile, nTiles;
+        /** true if the image could not be read, only set at the end of an image */
+        bool failed;
+
+        ImageTile() : data(NULL), xmin(0), ymin(0), xmax(0), ymax(0), iTile(0), nTiles(0), failed(false) {}
+    };
+
+    /**
+    * @brief Reads images tile by tile in a background thread while the tiles read before are uploaded
+    *
+    * Images are read in the order they are added, with the data types of the attributes of the target slice. Tiles follow the chunk grid of the
+    * slice, so that every tile touches a single chunk. At most SCIDB4GDAL_INGEST_QUEUE tiles wait for their upload, reading pauses while the
+    * queue is full. Images added while an image is uploaded are hence read during the upload. An image must not be used by any other thread
+    * before all of its tiles have been taken from the reader.
+    */
+    class TileReader {
+    public:
+        /**
+        * @brief Creates a reader without images
+        * @param slice the target temporal slice, defines data types and chunk grid
+        */
+        TileReader(SciDBSpatioTemporalArray& slice);
+
+        /**
+        * @brief Stops reading and drops all tiles that have not been taken
+        */
+        ~TileReader();
+
+        /**
+        * @brief Adds an image to be read after all images added before
+        * @param poSrcDS the image, not owned by the reader
+        * @param x0 target x coordinate of the first column of the image
+        * @param y0 target y coordinate of the first row of the image
+        */
+        void add(GDALDataset* poSrcDS, int64_t x0, int64_t y0);
+
+        /**
+        * @brief Takes the next tile of the current image, waits until it has been read
+        * @param tile the next tile, its data must be freed by the caller
+        * @return false at the end of the image, tile then tells whether reading failed
+        */
+        bool next(ImageTile& tile);
+
+    private:
+        /** an image to read */
+        struct Job {
+            GDALDataset* poSrcDS;
+            int64_t x0, y0;
+        };
+
+        /** thread function, reads all added images until the reader is destroyed */
+        static void run(void* reader);
+
+        /**
+        * @brief Reads the tiles of an image into the queue
+        * @return false if the reader is being destroyed
+        */
+        bool read(const Job& job);
+
+        /**
+        * @brief Queues a tile, waits while the queue is full
+        * @return false if the reader is being destroyed, the tile is not queued then
+        */
+        bool push(const ImageTile& tile);
+
+        /** data types of the attributes */
+        vector<SciDBTypeDesc> _types;
+        /** size of one interleaved cell in bytes */
+        size_t _pixelSize;
+        /** origin and chunk size of the chunk grid */
+        int64_t _xstart, _ystart, _xcs, _ycs;
+
+        /** images that have not been read yet */
+        deque<Job> _jobs;
+        /** tiles that have not been taken yet */
+        deque<ImageTile> _tiles;
+        /** set when the reader is destroyed */
+        bool _stop;
+        /** guards _jobs, _tiles and _stop */
+        CPLMutex* _hMutex;
+        /** signals changes of _jobs, _tiles and _stop */
+        CPLCond* _hCond;
+        /** reading thread, started with the first image */
+        CPLJoinableThread* _hThread;
+    };
+}
+
+#endif
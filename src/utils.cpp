@@ -26,6 +26,7 @@ SOFTWARE.
 #include <ctime>
 #include <sstream>
 #include <cctype>
+#include <limits>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -67,25 +68,153 @@ namespace scidb4gdal {
             CPLDebug("scidb4gdal", msg.c_str(), "");
         }
 
-        GDALDataType scidbTypeIdToGDALType(const string& typeId) {
-            // see src/query/TypeSystem.h of SciDB for definitions
+        // Indexed by SciDBType, see src/query/TypeSystem.h of SciDB for definitions
+        static const SciDBTypeDesc SCIDB_TYPES[] = {
+            {SCIDB_TYPE_UNKNOWN, 0, GDT_Unknown, false, false, false, 0},
+            {SCIDB_TYPE_INT8, 1, GDT_Byte, true, true, false, SCIDB4GDAL_DEFAULTNODATA_UINT8}, // signed vs unsigned might lead to conflicts
+            {SCIDB_TYPE_INT16, 2, GDT_Int16, true, true, false, SCIDB4GDAL_DEFAULTNODATA_INT16},
+            {SCIDB_TYPE_INT32, 4, GDT_Int32, true, true, false, SCIDB4GDAL_DEFAULTNODATA_INT32},
+            {SCIDB_TYPE_INT64, 8, GDT_Unknown, true, true, false, 0}, // No GDAL support for int64, uint64
+            {SCIDB_TYPE_UINT8, 1, GDT_Byte, true, false, false, SCIDB4GDAL_DEFAULTNODATA_UINT8},
+            {SCIDB_TYPE_UINT16, 2, GDT_UInt16, true, false, false, SCIDB4GDAL_DEFAULTNODATA_UINT16},
+            {SCIDB_TYPE_UINT32, 4, GDT_UInt32, true, false, false, SCIDB4GDAL_DEFAULTNODATA_UINT32},
+            {SCIDB_TYPE_UINT64, 8, GDT_Unknown, true, false, false, 0},
+            {SCIDB_TYPE_FLOAT, 4, GDT_Float32, false, true, true, SCIDB4GDAL_DEFAULTNODATA_FLOAT},
+            {SCIDB_TYPE_DOUBLE, 8, GDT_Float64, false, true, true, SCIDB4GDAL_DEFAULTNODATA_DOUBLE}
+        };
+
+        const SciDBTypeDesc& scidbTypeDesc(SciDBType type) {
+            return SCIDB_TYPES[type];
+        }
+
+        const SciDBTypeDesc& scidbTypeDesc(const string& typeId) {
             if (typeId == "int8")
-                return GDT_Byte; // signed vs unsigned might lead to conflicts
+                return SCIDB_TYPES[SCIDB_TYPE_INT8];
             else if (typeId == "int16")
-                return GDT_Int16;
+                return SCIDB_TYPES[SCIDB_TYPE_INT16];
             else if (typeId == "int32")
-                return GDT_Int32;
+                return SCIDB_TYPES[SCIDB_TYPE_INT32];
+            else if (typeId == "int64")
+                return SCIDB_TYPES[SCIDB_TYPE_INT64];
             else if (typeId == "uint8")
-                return GDT_Byte;
+                return SCIDB_TYPES[SCIDB_TYPE_UINT8];
             else if (typeId == "uint16")
-                return GDT_UInt16;
+                return SCIDB_TYPES[SCIDB_TYPE_UINT16];
             else if (typeId == "uint32")
-                return GDT_UInt32;
+                return SCIDB_TYPES[SCIDB_TYPE_UINT32];
+            else if (typeId == "uint64")
+                return SCIDB_TYPES[SCIDB_TYPE_UINT64];
             else if (typeId == "float")
-                return GDT_Float32;
+                return SCIDB_TYPES[SCIDB_TYPE_FLOAT];
             else if (typeId == "double")
-                return GDT_Float64;
-            return GDT_Unknown; // No GDAL support for int64, uint64, string
+                return SCIDB_TYPES[SCIDB_TYPE_DOUBLE];
+            return SCIDB_TYPES[SCIDB_TYPE_UNKNOWN];
+        }
+
+        template<typename T> static void fillTyped(void* dest, size_t n, double value) {
+            T v = (T) value;
+            T* p = (T*) dest;
+            for (size_t i = 0; i < n; ++i) p[i] = v;
+        }
+
+        void fillValue(void* dest, size_t n, const SciDBTypeDesc& type, double value) {
+            switch (type.type) {
+                case SCIDB_TYPE_INT8: fillTyped<int8_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_INT16: fillTyped<int16_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_INT32: fillTyped<int32_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_INT64: fillTyped<int64_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_UINT8: fillTyped<uint8_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_UINT16: fillTyped<uint16_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_UINT32: fillTyped<uint32_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_UINT64: fillTyped<uint64_t>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_FLOAT: fillTyped<float>(dest, n, value);
+                    break;
+                case SCIDB_TYPE_DOUBLE: fillTyped<double>(dest, n, value);
+                    break;
+                default:
+                    memset(dest, 0, n * type.bytes);
+            }
+        }
+
+        template<typename T> static void accumulateTyped(BandAccumulator& acc, const T* v, size_t n, bool hasNoData, double noData) {
+            // a no data value that is not representable by T cannot occur
+            const double lo = std::numeric_limits<T>::is_integer ? (double) std::numeric_limits<T>::min() : -(double) std::numeric_limits<T>::max();
+            if (!(noData >= lo && noData <= (double) std::numeric_limits<T>::max())) hasNoData = false;
+            const T nd = hasNoData ? (T) noData : (T) 0;
+            if ((double) nd != noData) hasNoData = false;
+
+            // plain loops with conditional updates instead of branches, auto-vectorized by the compiler
+            uint64_t nb = 0;
+            double sum = 0;
+            T mn = std::numeric_limits<T>::max();
+            T mx = std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min() : -std::numeric_limits<T>::max();
+            for (size_t i = 0; i < n; ++i) {
+                const T x = v[i];
+                const bool ok = (x == x) && !(hasNoData && x == nd);
+                nb += ok;
+                sum += ok ? (double) x : 0.0;
+                mn = (ok && x < mn) ? x : mn;
+                mx = (ok && x > mx) ? x : mx;
+            }
+            if (nb == 0) return;
+            const double meanb = sum / nb;
+            double m2b = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const T x = v[i];
+                const bool ok = (x == x) && !(hasNoData && x == nd);
+                const double d = ok ? (double) x - meanb : 0.0;
+                m2b += d * d;
+            }
+            acc.merge(nb, (double) mn, (double) mx, meanb, m2b);
+
+            if (!acc.valueCounts.empty()) {
+                const int64_t size = (int64_t) acc.valueCounts.size();
+                for (size_t i = 0; i < n; ++i) {
+                    const T x = v[i];
+                    if (x != x || (hasNoData && x == nd)) continue;
+                    const int64_t k = (int64_t) x - acc.valueOffset;
+                    if (k >= 0 && k < size) ++acc.valueCounts[k];
+                }
+            }
+        }
+
+        void accumulateBand(BandAccumulator& acc, const void* src, size_t n, const SciDBTypeDesc& type, bool hasNoData, double noData) {
+            switch (type.type) {
+                case SCIDB_TYPE_INT8: accumulateTyped<int8_t>(acc, (const int8_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_INT16: accumulateTyped<int16_t>(acc, (const int16_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_INT32: accumulateTyped<int32_t>(acc, (const int32_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_INT64: accumulateTyped<int64_t>(acc, (const int64_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_UINT8: accumulateTyped<uint8_t>(acc, (const uint8_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_UINT16: accumulateTyped<uint16_t>(acc, (const uint16_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_UINT32: accumulateTyped<uint32_t>(acc, (const uint32_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_UINT64: accumulateTyped<uint64_t>(acc, (const uint64_t*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_FLOAT: accumulateTyped<float>(acc, (const float*) src, n, hasNoData, noData);
+                    break;
+                case SCIDB_TYPE_DOUBLE: accumulateTyped<double>(acc, (const double*) src, n, hasNoData, noData);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        GDALDataType scidbTypeIdToGDALType(const string& typeId) {
+            return scidbTypeDesc(typeId).gdalType;
         }
 
         string gdalTypeToSciDBTypeId(GDALDataType type) {
@@ -107,24 +236,7 @@ namespace scidb4gdal {
         }
 
         size_t scidbTypeIdBytes(const string& typeId) {
-            // int64 and uint64 not supported by GDAL
-            if (typeId == "int8")
-                return 1;
-            else if (typeId == "int16")
-                return 2;
-            else if (typeId == "int32")
-                return 4;
-            else if (typeId == "uint8")
-                return 1;
-            else if (typeId == "uint16")
-                return 2;
-            else if (typeId == "uint32")
-                return 4;
-            else if (typeId == "float")
-                return 4;
-            else if (typeId == "double")
-                return 8;
-            return 0;
+            return scidbTypeDesc(typeId).bytes;
         }
 
         size_t gdalTypeBytes(GDALDataType type) {
@@ -168,7 +280,7 @@ namespace scidb4gdal {
         }
 
         double defaultNoDataSciDB(const string& typeId) {
-            return defaultNoDataGDAL(scidbTypeIdToGDALType(typeId));
+            return scidbTypeDesc(typeId).defaultNoData;
         }
 
         void sleep(long int ms) {
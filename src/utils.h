@@ -44,11 +44,19 @@ SOFTWARE.
 #define SCIDB4GDAL_ARRAYSUFFIX_TEMP "_temp"
 #define SCIDB4GDAL_ARRAYSUFFIX_TEMPLOAD "_tempload"
 #define SCIDB4GDAL_ARRAYSUFFIX_COLLECTION_INTEGRATION "_integrate"
+#define SCIDB4GDAL_ARRAYSUFFIX_STAGING "_staging"
+#define SCIDB4GDAL_ARRAYSUFFIX_SLICE "_slice"
 
 //#define SCIDB4GDAL_ARRAY_PREFIX "GDAL_" // Names of created arrays get a prefix, not yet implemented
 
 #define SCIDB4GDAL_MAINMEM_HARD_LIMIT_MB 1024
 
+#define SCIDB4GDAL_DEFAULT_STATS_SAMPLE 0.01 // fraction of cells sampled for approximate statistics
+#define SCIDB4GDAL_STATS_SAMPLE_SEED 4242 // fixed seed, approximate statistics are reproducible
+#define SCIDB4GDAL_DEFAULT_DENSE_THRESHOLD 1.0 // blocks are fetched as values only after a block without empty cells
+#define SCIDB4GDAL_READ_STRATEGY_PROBES 2 // blocks read with each of subarray() and between() before choosing the faster one
+#define SCIDB4GDAL_READ_STRATEGY_REPROBE 50 // every n-th block is read with the slower operator to follow changes of the latencies
+
 #define SCIDB_MAX_DIM_INDEX 4611686018427387903             //  same as 1 << 62 - 1
 
 #define SCIDB4GDAL_DEFAULTNODATA_INT8 -pow(2, 7)
@@ -69,11 +77,20 @@ SOFTWARE.
 #define SCIDB4GDAL_DEFAULTMDFIELD_OFFSET  "OFFSET"
 #define SCIDB4GDAL_DEFAULTMDFIELD_MAX     "MAX"
 #define SCIDB4GDAL_DEFAULTMDFIELD_MIN     "MIN"
+#define SCIDB4GDAL_DEFAULTMDFIELD_STATS_MIN    "STATISTICS_MINIMUM"
+#define SCIDB4GDAL_DEFAULTMDFIELD_STATS_MAX    "STATISTICS_MAXIMUM"
+#define SCIDB4GDAL_DEFAULTMDFIELD_STATS_MEAN   "STATISTICS_MEAN"
+#define SCIDB4GDAL_DEFAULTMDFIELD_STATS_STDDEV "STATISTICS_STDDEV"
+#define SCIDB4GDAL_DEFAULTMDFIELD_STATS_APPROX "STATISTICS_APPROXIMATE"
+#define SCIDB4GDAL_DEFAULTMDFIELD_HIST_MIN     "HISTOGRAM_MIN"
+#define SCIDB4GDAL_DEFAULTMDFIELD_HIST_MAX     "HISTOGRAM_MAX"
+#define SCIDB4GDAL_DEFAULTMDFIELD_HIST_COUNTS  "HISTOGRAM_COUNTS" // blank separated
 
 #include <string>
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstring>
 #include <inttypes.h>
 #include <exception>
 
@@ -148,6 +165,8 @@ namespace scidb4gdal {
         /** Error stating that no spatial or temporal queries can be executed in SciDB
         */
         ERR_GLOBAL_NO_SCIDB4GEO = 300 + 6,
+        /** Error for an invalid value of an opening or creation option */
+        ERR_GLOBAL_INVALIDOPTION = 300 + 7,
         /** Default error if something went wrong */
         ERR_GLOBAL_UNKNOWN = 300 + 99,
         /** Error when no spatial reference can be found for a bounding box */
@@ -162,7 +181,334 @@ namespace scidb4gdal {
 
     };
 
+    /**
+    * @brief SciDB attribute data types known to the driver
+    */
+    enum SciDBType {
+        SCIDB_TYPE_UNKNOWN = 0,
+        SCIDB_TYPE_INT8,
+        SCIDB_TYPE_INT16,
+        SCIDB_TYPE_INT32,
+        SCIDB_TYPE_INT64,
+        SCIDB_TYPE_UINT8,
+        SCIDB_TYPE_UINT16,
+        SCIDB_TYPE_UINT32,
+        SCIDB_TYPE_UINT64,
+        SCIDB_TYPE_FLOAT,
+        SCIDB_TYPE_DOUBLE
+    };
+
+    /**
+    * @brief Precomputed properties of a SciDB data type
+    *
+    * Type descriptors are resolved once from the SciDB type identifier string, e.g. when the array schema is loaded,
+    * such that per-pixel or per-row code does not need to compare type strings.
+    */
+    struct SciDBTypeDesc {
+        /** type enumeration item */
+        SciDBType type;
+        /** size of one value in bytes, 0 if unknown */
+        size_t bytes;
+        /** corresponding GDAL data type, GDT_Unknown if not supported by GDAL */
+        GDALDataType gdalType;
+        /** true for integer types */
+        bool isInteger;
+        /** true for signed integer and floating point types */
+        bool isSigned;
+        /** true for floating point types */
+        bool isFloatingPoint;
+        /** default no data value used for this type */
+        double defaultNoData;
+    };
+
+    /**
+    * @brief Running statistics of a band, e.g. while uploading an image block by block
+    */
+    struct BandAccumulator {
+        /** number of valid values */
+        uint64_t n;
+        /** smallest valid value */
+        double min;
+        /** largest valid value */
+        double max;
+        /** mean of the valid values */
+        double mean;
+        /** sum of squared deviations from the mean */
+        double m2;
+        /** number of occurrences per value of 8 and 16 bit integer bands, empty if no histogram is accumulated */
+        vector<uint64_t> valueCounts;
+        /** the value counted by valueCounts[0] */
+        int32_t valueOffset;
+
+        BandAccumulator() : n(0), min(DBL_MAX), max(-DBL_MAX), mean(0), m2(0), valueOffset(0) {}
+
+        /**
+        * @brief Adds the statistics of a further block of values, see Chan et al. (1979)
+        */
+        void merge(uint64_t nb, double minb, double maxb, double meanb, double m2b) {
+            if (nb == 0) return;
+            if (minb < min) min = minb;
+            if (maxb > max) max = maxb;
+            double delta = meanb - mean;
+            uint64_t nt = n + nb;
+            mean += delta * nb / nt;
+            m2 += m2b + delta * delta * ((double) n * nb / nt);
+            n = nt;
+        }
+
+        /**
+        * @brief Returns the sample standard deviation like SciDB's stdev() aggregate
+        */
+        double stdev() const { return n > 1 ? sqrt(m2 / (n - 1)) : 0; }
+    };
+
     namespace Utils {
+    /**
+    * @brief Returns the descriptor of a SciDB data type
+    * @param typeId SciDB type identifier string e.g. "int32"
+    * @return descriptor, with type SCIDB_TYPE_UNKNOWN for unsupported types
+    */
+    const SciDBTypeDesc& scidbTypeDesc(const string& typeId);
+
+    /**
+    * @brief Returns the descriptor of a SciDB data type
+    * @param type type enumeration item
+    * @return descriptor
+    */
+    const SciDBTypeDesc& scidbTypeDesc(SciDBType type);
+
+    /**
+    * @brief Integer division rounding towards negative infinity, e.g. the index of the chunk of a coordinate below the dimension start
+    * @param a dividend
+    * @param b divisor, greater than 0
+    * @return floor(a / b)
+    */
+    inline int64_t floorDiv(int64_t a, int64_t b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    /**
+    * @brief Copies a single band into a band interleaved by pixel buffer, cell size known at compile time
+    * @param dest interleaved buffer
+    * @param src band sequential values
+    * @param n number of cells
+    * @param pixelSize size of one interleaved cell in bytes, i.e. sum of all band sizes
+    * @param bandOffset byte offset of the band within an interleaved cell
+    */
+    template<size_t N> inline void interleaveBand(uint8_t* dest, const uint8_t* src, size_t n, size_t pixelSize, size_t bandOffset) {
+        dest += bandOffset;
+        for (size_t i = 0; i < n; ++i) {
+            memcpy(dest, src, N);
+            dest += pixelSize;
+            src += N;
+        }
+    }
+
+    /**
+    * @brief Copies a single band into a band interleaved by pixel buffer
+    *
+    * Dispatches to the compile time specialized kernel for the given value size.
+    * @param bytes size of one value of the band in bytes
+    * @param dest interleaved buffer
+    * @param src band sequential values
+    * @param n number of cells
+    * @param pixelSize size of one interleaved cell in bytes, i.e. sum of all band sizes
+    * @param bandOffset byte offset of the band within an interleaved cell
+    */
+    inline void interleaveBand(size_t bytes, uint8_t* dest, const uint8_t* src, size_t n, size_t pixelSize, size_t bandOffset) {
+        switch (bytes) {
+            case 1: interleaveBand<1>(dest, src, n, pixelSize, bandOffset);
+                break;
+            case 2: interleaveBand<2>(dest, src, n, pixelSize, bandOffset);
+                break;
+            case 4: interleaveBand<4>(dest, src, n, pixelSize, bandOffset);
+                break;
+            case 8: interleaveBand<8>(dest, src, n, pixelSize, bandOffset);
+                break;
+            default:
+                dest += bandOffset;
+                for (size_t i = 0; i < n; ++i) memcpy(&dest[i * pixelSize], &src[i * bytes], bytes);
+        }
+    }
+
+    /**
+    * @brief Writes (value, position) records of non-empty cells into a band buffer
+    *
+    * Each record consists of a value of N bytes followed by the int64 linear position of the cell. Values of nullable attributes are
+    * preceded by the missing reason byte of SciDB's binary format, which is -1 for values that are not null. Null values and records
+    * with positions outside the buffer are ignored.
+    * @param dest band buffer with space for n values, usually prefilled with no data values
+    * @param mask if not NULL, set to 255 at the position of each record, i.e. of each non-empty cell, null or not
+    * @param n number of cells of the band buffer
+    * @param rec records
+    * @param nrec number of records
+    */
+    template<size_t N, bool NULLABLE> inline void scatterCells(uint8_t* dest, uint8_t* mask, size_t n, const uint8_t* rec, size_t nrec) {
+        const size_t v = NULLABLE ? 1 : 0;
+        for (size_t i = 0; i < nrec; ++i) {
+            int64_t pos;
+            memcpy(&pos, rec + v + N, sizeof(int64_t));
+            if (pos >= 0 && (uint64_t) pos < n) {
+                if (!NULLABLE || rec[0] == 0xFF) memcpy(dest + (size_t) pos * N, rec + v, N);
+                if (mask) mask[pos] = 255;
+            }
+            rec += v + N + sizeof(int64_t);
+        }
+    }
+
+    /**
+    * @brief Writes (value, position) records of non-empty cells into a band buffer
+    *
+    * Dispatches to the compile time specialized kernel for the given value size.
+    * @param bytes size of one value of the band in bytes
+    * @param nullable whether values are preceded by a missing reason byte
+    * @param dest band buffer with space for n values, usually prefilled with no data values
+    * @param mask if not NULL, set to 255 at the position of each record, i.e. of each non-empty cell, null or not
+    * @param n number of cells of the band buffer
+    * @param rec records
+    * @param nrec number of records
+    */
+    inline void scatterCells(size_t bytes, bool nullable, uint8_t* dest, uint8_t* mask, size_t n, const uint8_t* rec, size_t nrec) {
+        switch (bytes) {
+            case 1: nullable ? scatterCells<1, true>(dest, mask, n, rec, nrec) : scatterCells<1, false>(dest, mask, n, rec, nrec);
+                break;
+            case 2: nullable ? scatterCells<2, true>(dest, mask, n, rec, nrec) : scatterCells<2, false>(dest, mask, n, rec, nrec);
+                break;
+            case 4: nullable ? scatterCells<4, true>(dest, mask, n, rec, nrec) : scatterCells<4, false>(dest, mask, n, rec, nrec);
+                break;
+            case 8: nullable ? scatterCells<8, true>(dest, mask, n, rec, nrec) : scatterCells<8, false>(dest, mask, n, rec, nrec);
+                break;
+            default:
+                const size_t v = nullable ? 1 : 0;
+                for (size_t i = 0; i < nrec; ++i, rec += v + bytes + sizeof(int64_t)) {
+                    int64_t pos;
+                    memcpy(&pos, rec + v + bytes, sizeof(int64_t));
+                    if (pos < 0 || (uint64_t) pos >= n) continue;
+                    if (!nullable || rec[0] == 0xFF) memcpy(dest + (size_t) pos * bytes, rec + v, bytes);
+                    if (mask) mask[pos] = 255;
+                }
+        }
+    }
+
+    /**
+    * @brief Replaces null values of SciDB's nullable binary format by a no data value
+    *
+    * Each value of N bytes in src is preceded by a missing reason byte, which is -1 for values that are not null.
+    * The selection does not branch, such that the compiler can vectorize the loop.
+    * @param dest buffer with space for n values
+    * @param src n nullable values
+    * @param n number of values
+    * @param nodata the no data value as N bytes of the value type
+    */
+    template<size_t N> inline void replaceNulls(uint8_t* dest, const uint8_t* src, size_t n, const uint8_t* nodata) {
+        for (size_t i = 0; i < n; ++i) {
+            const uint8_t valid = (uint8_t) -(src[0] == 0xFF);
+            for (size_t k = 0; k < N; ++k)
+                dest[k] = (uint8_t) ((src[1 + k] & valid) | (nodata[k] & ~valid));
+            dest += N;
+            src += 1 + N;
+        }
+    }
+
+    /**
+    * @brief Replaces null values of SciDB's nullable binary format by a no data value
+    *
+    * Dispatches to the compile time specialized kernel for the given value size.
+    * @param bytes size of one value in bytes
+    * @param dest buffer with space for n values
+    * @param src n nullable values
+    * @param n number of values
+    * @param nodata the no data value as bytes of the value type
+    */
+    inline void replaceNulls(size_t bytes, uint8_t* dest, const uint8_t* src, size_t n, const uint8_t* nodata) {
+        switch (bytes) {
+            case 1: replaceNulls<1>(dest, src, n, nodata);
+                break;
+            case 2: replaceNulls<2>(dest, src, n, nodata);
+                break;
+            case 4: replaceNulls<4>(dest, src, n, nodata);
+                break;
+            case 8: replaceNulls<8>(dest, src, n, nodata);
+                break;
+            default:
+                for (size_t i = 0; i < n; ++i, dest += bytes, src += 1 + bytes)
+                    memcpy(dest, (src[0] == 0xFF) ? src + 1 : nodata, bytes);
+        }
+    }
+
+    /**
+    * @brief Transposes a row major matrix of values of type T
+    *
+    * The matrix is processed in square tiles that fit into the L1 cache, such that both reading and writing access memory
+    * contiguously within a tile. Inner loops work on values of fixed size, which lets the compiler vectorize them.
+    * @param dest output with cols rows of rows values
+    * @param src input with rows rows of cols values
+    * @param rows number of rows of src
+    * @param cols number of columns of src
+    */
+    template<typename T> inline void transposeTyped(T* dest, const T* src, size_t rows, size_t cols) {
+        const size_t tile = 64 / sizeof(T) < 8 ? 8 : 64 / sizeof(T); // one cache line per tile row
+        for (size_t r0 = 0; r0 < rows; r0 += tile) {
+            const size_t r1 = r0 + tile < rows ? r0 + tile : rows;
+            for (size_t c0 = 0; c0 < cols; c0 += tile) {
+                const size_t c1 = c0 + tile < cols ? c0 + tile : cols;
+                for (size_t c = c0; c < c1; ++c) {
+                    T* d = dest + c * rows;
+                    for (size_t r = r0; r < r1; ++r) d[r] = src[r * cols + c];
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief Transposes a row major matrix, e.g. a block of an array whose x dimension precedes the y dimension
+    *
+    * Dispatches to the specialized kernel for the given value size.
+    * @param bytes size of one value in bytes
+    * @param dest output with cols rows of rows values
+    * @param src input with rows rows of cols values
+    * @param rows number of rows of src
+    * @param cols number of columns of src
+    */
+    inline void transpose(size_t bytes, void* dest, const void* src, size_t rows, size_t cols) {
+        switch (bytes) {
+            case 1: transposeTyped<uint8_t>((uint8_t*) dest, (const uint8_t*) src, rows, cols);
+                break;
+            case 2: transposeTyped<uint16_t>((uint16_t*) dest, (const uint16_t*) src, rows, cols);
+                break;
+            case 4: transposeTyped<uint32_t>((uint32_t*) dest, (const uint32_t*) src, rows, cols);
+                break;
+            case 8: transposeTyped<uint64_t>((uint64_t*) dest, (const uint64_t*) src, rows, cols);
+                break;
+            default:
+                for (size_t r = 0; r < rows; ++r)
+                    for (size_t c = 0; c < cols; ++c)
+                        memcpy((uint8_t*) dest + (c * rows + r) * bytes, (const uint8_t*) src + (r * cols + c) * bytes, bytes);
+        }
+    }
+
+    /**
+    * @brief Fills a buffer with a constant value of the given type, e.g. with no data values
+    * @param dest buffer with space for n values
+    * @param n number of values
+    * @param type descriptor of the value type
+    * @param value the value, converted to the given type
+    */
+    void fillValue(void* dest, size_t n, const SciDBTypeDesc& type, double value);
+
+    /**
+    * @brief Adds a block of band values to running statistics
+    *
+    * NaN values and values equal to the no data value are ignored. Values are counted in acc.valueCounts if it is not empty.
+    * @param acc running statistics of the band
+    * @param src band sequential values
+    * @param n number of values
+    * @param type descriptor of the value type
+    * @param hasNoData whether noData shall be ignored
+    * @param noData the no data value
+    */
+    void accumulateBand(BandAccumulator& acc, const void* src, size_t n, const SciDBTypeDesc& type, bool hasNoData, double noData);
+
     /**
     * @brief Maps SciDB string type identifiers to GDAL data type enumeration items.
     * @param typeId SciDB type identifier string e.g. "int32"
@@ -193,10 +539,7 @@ namespace scidb4gdal {
     * @return true if typeId is integer, false otherwise
     */
     inline bool scidbTypeIdIsInteger(const string& typeId) {
-        return (typeId.compare("int32") == 0) || (typeId.compare("int8") == 0) ||
-            (typeId.compare("int16") == 0) || (typeId.compare("int64") == 0) ||
-            (typeId.compare("uint32") == 0) || (typeId.compare("uint8") == 0) ||
-            (typeId.compare("uint16") == 0) || (typeId.compare("uint64") == 0);
+        return scidbTypeDesc(typeId).isInteger;
     }
 
     /**
@@ -205,7 +548,7 @@ namespace scidb4gdal {
     * @return true if typeId is a floating point number, false otherwise
     */
     inline bool scidbTypeIdIsFloatingPoint(const string& typeId) {
-        return (typeId.compare("float") == 0) || (typeId.compare("double") == 0);
+        return scidbTypeDesc(typeId).isFloatingPoint;
     }
 
     /**
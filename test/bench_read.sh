@@ -0,0 +1,154 @@
+#!/bin/bash
+# Times the download of dense and sparse arrays with the read strategies of the driver
+# and the client-side transpose against transpose() on the server.
+# Needs GDAL with the SciDB driver, curl and a SciDB server running shim. The host
+# must include http:// or https://. See bench_transpose.cpp for the transpose kernels.
+outputFolder="/tmp/"
+cd "${outputFolder}"
+
+#number of runs per measurement
+runs=3
+
+#download chicago black-white geotiff image
+chicago="./UTM2GTIF.TIF"
+if (! test -f ${chicago})
+then
+wget "http://download.osgeo.org/geotiff/samples/spot/chicago/UTM2GTIF.TIF"
+fi
+
+#change connection details for scidb and uncomment it
+#user="scidb"
+#passwd="scidb"
+#host="https://localhost"
+#port=31000
+
+: ${SCIDB4GDAL_USER:=$user}
+: ${SCIDB4GDAL_PASSWD:=$passwd}
+: ${SCIDB4GDAL_HOST:=$host}
+: ${SCIDB4GDAL_PORT:=$port}
+export SCIDB4GDAL_USER
+export SCIDB4GDAL_PASSWD
+export SCIDB4GDAL_HOST
+export SCIDB4GDAL_PORT
+
+#scidb array names
+denseArray=bench_chicago_dense
+sparseArray=bench_chicago_sparse
+denseXYArray=bench_chicago_dense_xy
+
+#input and output file names
+chicago_part="./bench_chicago_part.tif"
+output="./bench_out.tif"
+srs="EPSG:26716"
+
+#create a log file
+log="./bench.log"
+rm -f $log
+touch $log
+exec >> $log
+exec 2>&1
+
+#runs a download $runs times, arguments are the label and the opening options
+function bench {
+  label=$1
+  shift
+  for ((i = 1; i <= runs; i++))
+  do
+    rm -f $output
+    TIMEFORMAT="${label} run ${i} took %R seconds"
+    time gdal_translate "$@" -of GTiff "SCIDB:array=${array}" $output > /dev/null
+  done
+}
+
+#shim requests bypassing the driver
+shimUrl="${SCIDB4GDAL_HOST}:${SCIDB4GDAL_PORT}"
+curlopts=(-s -k --digest -u "${SCIDB4GDAL_USER}:${SCIDB4GDAL_PASSWD}")
+auth=()
+if [[ ${SCIDB4GDAL_HOST} == https* ]]
+then
+  token=$(curl "${curlopts[@]}" -G "${shimUrl}/login" --data-urlencode "username=${SCIDB4GDAL_USER}" --data-urlencode "password=${SCIDB4GDAL_PASSWD}")
+  auth=(--data-urlencode "auth=${token}")
+fi
+
+#runs an AFL query and downloads its binary result, arguments are the query and the save format
+function shim {
+  id=$(curl "${curlopts[@]}" -G "${shimUrl}/new_session" "${auth[@]}")
+  save=()
+  if [ -n "$2" ]
+  then
+    save=(--data-urlencode "save=$2")
+  fi
+  curl "${curlopts[@]}" -G "${shimUrl}/execute_query" --data-urlencode "id=${id}" --data-urlencode "query=$1" "${save[@]}" "${auth[@]}" > /dev/null
+  if [ -n "$2" ]
+  then
+    curl "${curlopts[@]}" -G "${shimUrl}/read_bytes" --data-urlencode "id=${id}" --data-urlencode "n=0" "${auth[@]}" > /dev/null
+  fi
+  curl "${curlopts[@]}" -G "${shimUrl}/release_session" --data-urlencode "id=${id}" "${auth[@]}" > /dev/null
+}
+
+#runs a shim download $runs times, arguments are the label, the query and the save format
+function benchShim {
+  for ((i = 1; i <= runs; i++))
+  do
+    TIMEFORMAT="$1 run ${i} took %R seconds"
+    time shim "$2" "$3"
+  done
+}
+
+echo ""
+echo "###########################################"
+echo "# Preparing benchmark arrays"
+echo "###########################################"
+echo ""
+if (! test -f $chicago_part)
+then
+  echo gdal_translate -of GTiff -srcwin 350 465 349 464 $chicago $chicago_part
+  gdal_translate -of GTiff -srcwin 350 465 349 464 $chicago $chicago_part
+  echo ""
+fi
+gdalmanage delete "SCIDB:array=${denseArray} confirmDelete=y"
+gdalmanage delete "SCIDB:array=${sparseArray} confirmDelete=y"
+gdalmanage delete "SCIDB:array=${denseXYArray} confirmDelete=y"
+
+#dense: every cell of the array holds a value
+echo gdal_translate -co \"type=S\" -of SciDB ${chicago} \"SCIDB:array=${denseArray}\"
+gdal_translate -co "type=S" -of SciDB "${chicago}" "SCIDB:array=${denseArray}"
+
+#sparse: one quarter of the image in a bounding box of about four times the size of the whole image
+echo gdal_translate -co \"bbox=437000 4660000 461000 4619000\" -co \"srs=${srs}\" -co \"type=S\" -of SciDB ${chicago_part} \"SCIDB:array=${sparseArray}\"
+gdal_translate -co "bbox=437000 4660000 461000 4619000" -co "srs=${srs}" -co "type=S" -of SciDB "${chicago_part}" "SCIDB:array=${sparseArray}"
+
+echo ""
+echo "###########################################"
+echo "# subarray() versus between()"
+echo "###########################################"
+echo ""
+for array in $denseArray $sparseArray
+do
+  echo "****** ${array}"
+  bench "${array} subarray" -oo "read_strategy=subarray"
+  bench "${array} between" -oo "read_strategy=between"
+  bench "${array} auto" -oo "read_strategy=auto"
+  echo ""
+done
+
+echo ""
+echo "###########################################"
+echo "# Client-side transpose versus transpose()"
+echo "###########################################"
+echo ""
+#dense array with x preceding y, the driver transposes its blocks client-side
+echo "store(transpose(${denseArray}),${denseXYArray})"
+shim "store(transpose(${denseArray}),${denseXYArray})"
+shim "st_setsrs(${denseXYArray},'x','y','EPSG',26716,'x0=0 y0=0 a11=1 a22=-1 a12=0 a21=0')"
+array=$denseXYArray
+bench "${array} client-side transpose"
+#the same cells downloaded through shim, with and without transpose() on the server
+benchShim "${array} transpose() on the server" "transpose(${denseXYArray})" "(uint8)"
+benchShim "${array} without transpose" "scan(${denseXYArray})" "(uint8)"
+echo ""
+
+gdalmanage delete "SCIDB:array=${denseArray} confirmDelete=y"
+gdalmanage delete "SCIDB:array=${sparseArray} confirmDelete=y"
+gdalmanage delete "SCIDB:array=${denseXYArray} confirmDelete=y"
+rm -f $output
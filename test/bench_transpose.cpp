@@ -0,0 +1,61 @@
+/*
+Micro-benchmark of the client-side transpose of dense blocks, see Utils::transpose().
+
+Compares the blocked kernels against a naive double loop and checks that both give the same result. Build and run with
+
+    g++ -O2 -I../src $(gdal-config --cflags) bench_transpose.cpp -o bench_transpose && ./bench_transpose
+
+test/bench_read.sh compares the client-side transpose with transpose() on the server.
+*/
+
+#include "utils.h"
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+using namespace scidb4gdal;
+
+#define BENCH_TRANSPOSE_RUNS 200
+
+template <typename T> void naiveTranspose(T* dest, const T* src, size_t rows, size_t cols) {
+    for (size_t r = 0; r < rows; ++r)
+        for (size_t c = 0; c < cols; ++c) dest[c * rows + r] = src[r * cols + c];
+}
+
+template <typename T> void bench(size_t rows, size_t cols) {
+    std::vector<T> src(rows * cols), blocked(rows * cols), naive(rows * cols);
+    for (size_t i = 0; i < rows * cols; ++i) src[i] = (T)(i * 2654435761u);
+
+    naiveTranspose(&naive[0], &src[0], rows, cols);
+    Utils::transpose(sizeof(T), &blocked[0], &src[0], rows, cols);
+    bool ok = blocked == naive;
+
+    clock_t t0 = clock();
+    for (int k = 0; k < BENCH_TRANSPOSE_RUNS; ++k) Utils::transpose(sizeof(T), &blocked[0], &src[0], rows, cols);
+    double tblocked = (double)(clock() - t0) / CLOCKS_PER_SEC / BENCH_TRANSPOSE_RUNS;
+
+    t0 = clock();
+    for (int k = 0; k < BENCH_TRANSPOSE_RUNS; ++k) naiveTranspose(&naive[0], &src[0], rows, cols);
+    double tnaive = (double)(clock() - t0) / CLOCKS_PER_SEC / BENCH_TRANSPOSE_RUNS;
+
+    printf("%lu byte values, %lux%lu: blocked %.3f ms, naive %.3f ms%s\n", (unsigned long)sizeof(T), (unsigned long)rows,
+           (unsigned long)cols, tblocked * 1e3, tnaive * 1e3, ok ? "" : " WRONG RESULT");
+}
+
+int main() {
+    bench<uint8_t>(2048, 2048);
+    bench<uint16_t>(2048, 2048);
+    bench<uint32_t>(2048, 2048);
+    bench<uint64_t>(2048, 2048);
+    // block sizes that are no multiple of the tile size
+    bench<uint32_t>(513, 300);
+
+    // value sizes without a specialized kernel
+    std::vector<char> src(3 * 5 * 7), blocked(3 * 5 * 7), naive(3 * 5 * 7);
+    for (size_t i = 0; i < src.size(); ++i) src[i] = (char)i;
+    Utils::transpose(3, &blocked[0], &src[0], 5, 7);
+    for (size_t r = 0; r < 5; ++r)
+        for (size_t c = 0; c < 7; ++c) memcpy(&naive[(c * 5 + r) * 3], &src[(r * 7 + c) * 3], 3);
+    printf("3 byte values, 5x7: %s\n", blocked == naive ? "ok" : "WRONG RESULT");
+    return 0;
+}